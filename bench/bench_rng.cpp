@@ -0,0 +1,65 @@
+/***
+ * Murxla: A Model-Based API Fuzzer for SMT solvers.
+ *
+ * This file is part of Murxla.
+ *
+ * Copyright (C) 2019-2022 by the authors listed in the AUTHORS file.
+ *
+ * See LICENSE for more information on using this software.
+ */
+#include "bench_util.hpp"
+
+using namespace murxla;
+
+/* -------------------------------------------------------------------------- */
+
+namespace {
+
+/** Weights as maintained by TermRefs: mostly distinct, some maximal. */
+std::vector<size_t>
+mk_weights(size_t n)
+{
+  RNGenerator rng(bench::SEED);
+  std::vector<size_t> weights(n);
+  for (size_t i = 0; i < n; ++i)
+  {
+    weights[i] = rng.pick<size_t>(1, n);
+  }
+  return weights;
+}
+
+}  // namespace
+
+/* -------------------------------------------------------------------------- */
+
+static void
+rng_pick_weighted(benchmark::State& state)
+{
+  RNGenerator rng(bench::SEED);
+  std::vector<size_t> weights = mk_weights(state.range(0));
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(rng.pick_weighted(weights));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(rng_pick_weighted)->ArgName("weights")->RangeMultiplier(10)->Range(
+    100, 1000000);
+
+static void
+rng_pick_weighted_range(benchmark::State& state)
+{
+  RNGenerator rng(bench::SEED);
+  std::vector<size_t> weights = mk_weights(state.range(0));
+  /* Pick from the upper half only, as when picking from a scope level. */
+  auto begin = weights.begin() + weights.size() / 2;
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(rng.pick_weighted<size_t>(begin, weights.end()));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(rng_pick_weighted_range)
+    ->ArgName("weights")
+    ->RangeMultiplier(10)
+    ->Range(100, 1000000);
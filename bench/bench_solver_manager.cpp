@@ -0,0 +1,53 @@
+/***
+ * Murxla: A Model-Based API Fuzzer for SMT solvers.
+ *
+ * This file is part of Murxla.
+ *
+ * Copyright (C) 2019-2022 by the authors listed in the AUTHORS file.
+ *
+ * See LICENSE for more information on using this software.
+ */
+#include "bench_util.hpp"
+
+using namespace murxla;
+
+/* -------------------------------------------------------------------------- */
+
+static void
+smgr_pick_op_kind(benchmark::State& state)
+{
+  bench::Env env;
+  env.populate(state.range(0), state.range(1));
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(env.d_smgr.pick_op_kind());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(smgr_pick_op_kind)->Apply(bench::population_args);
+
+static void
+smgr_pick_op_kind_sort_kind(benchmark::State& state)
+{
+  bench::Env env;
+  env.populate(state.range(0), state.range(1));
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(env.d_smgr.pick_op_kind(true, SORT_BV));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(smgr_pick_op_kind_sort_kind)->Apply(bench::population_args);
+
+static void
+smgr_pick_op_kind_all_theories(benchmark::State& state)
+{
+  bench::Env env(TheoryVector{});
+  env.populate(state.range(0), state.range(1));
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(env.d_smgr.pick_op_kind());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(smgr_pick_op_kind_all_theories)->Apply(bench::population_args);
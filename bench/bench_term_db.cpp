@@ -0,0 +1,128 @@
+/***
+ * Murxla: A Model-Based API Fuzzer for SMT solvers.
+ *
+ * This file is part of Murxla.
+ *
+ * Copyright (C) 2019-2022 by the authors listed in the AUTHORS file.
+ *
+ * See LICENSE for more information on using this software.
+ */
+#include "bench_util.hpp"
+
+using namespace murxla;
+
+/* -------------------------------------------------------------------------- */
+
+namespace {
+
+/**
+ * Populate given term references with `num_terms` terms, distributed
+ * uniformly over `depth` scope levels.
+ */
+void
+populate(TermRefs& trefs, size_t num_terms, size_t depth)
+{
+  for (size_t i = 1; i < depth; ++i)
+  {
+    trefs.push();
+  }
+  /* Add level by level, terms are always added to the end of their level. */
+  for (size_t level = 0; level < depth; ++level)
+  {
+    for (size_t i = level; i < num_terms; i += depth)
+    {
+      trefs.add(bench::mk_const(8), level);
+    }
+  }
+}
+
+}  // namespace
+
+/* -------------------------------------------------------------------------- */
+
+static void
+term_refs_pick(benchmark::State& state)
+{
+  RNGenerator rng(bench::SEED);
+  TermRefs trefs(1);
+  populate(trefs, state.range(0), state.range(1));
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(trefs.pick(rng));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(term_refs_pick)->Apply(bench::population_args);
+
+static void
+term_refs_pick_level(benchmark::State& state)
+{
+  RNGenerator rng(bench::SEED);
+  TermRefs trefs(1);
+  size_t depth = state.range(1);
+  populate(trefs, state.range(0), depth);
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(trefs.pick(rng, depth - 1));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(term_refs_pick_level)->Apply(bench::population_args);
+
+static void
+term_db_add_term(benchmark::State& state)
+{
+  /* Number of terms added per batch, the added terms are removed between
+   * batches to keep the size of the database stable. */
+  const size_t batch_size = 1000;
+
+  bench::Env env;
+  TermDb tdb(env.d_smgr, env.d_rng);
+  size_t depth = state.range(1);
+  env.populate(tdb, state.range(0), depth);
+
+  std::vector<Term> terms;
+  Term var;
+  size_t i = batch_size;
+  for (auto _ : state)
+  {
+    if (i == batch_size)
+    {
+      state.PauseTiming();
+      if (var)
+      {
+        tdb.remove_var(var);
+      }
+      /* Add new terms in a fresh scope level on top. */
+      var = bench::mk_const(8);
+      tdb.add_var(var, env.d_sorts[1], SORT_BV);
+      terms.clear();
+      for (size_t j = 0; j < batch_size; ++j)
+      {
+        size_t idx = j % env.d_sorts.size();
+        terms.push_back(bench::mk_const(bench::BV_SIZES[idx]));
+      }
+      i = 0;
+      state.ResumeTiming();
+    }
+    size_t idx = i % env.d_sorts.size();
+    tdb.add_term(terms[i], env.d_sorts[idx], SORT_BV, {}, {depth});
+    ++i;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(term_db_add_term)->Apply(bench::population_args);
+
+static void
+term_db_pick_term(benchmark::State& state)
+{
+  bench::Env env;
+  TermDb tdb(env.d_smgr, env.d_rng);
+  env.populate(tdb, state.range(0), state.range(1));
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(tdb.pick_term(SORT_BV));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(term_db_pick_term)->Apply(bench::population_args);
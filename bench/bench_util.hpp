@@ -0,0 +1,191 @@
+/***
+ * Murxla: A Model-Based API Fuzzer for SMT solvers.
+ *
+ * This file is part of Murxla.
+ *
+ * Copyright (C) 2019-2022 by the authors listed in the AUTHORS file.
+ *
+ * See LICENSE for more information on using this software.
+ */
+#ifndef __MURXLA__BENCH_UTIL_H
+#define __MURXLA__BENCH_UTIL_H
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "fsm.hpp"
+#include "rng.hpp"
+#include "solver/smt2/smt2_solver.hpp"
+#include "solver/solver_profile.hpp"
+#include "solver_manager.hpp"
+#include "statistics.hpp"
+#include "term_db.hpp"
+
+namespace murxla {
+namespace bench {
+
+/* -------------------------------------------------------------------------- */
+
+/** Seed of all random number generators of the benchmarks. */
+const uint64_t SEED = 0x4d75726c61;
+
+/** The BV sizes of the sorts of generated terms. */
+const std::vector<uint32_t> BV_SIZES = {1, 8, 16, 32, 64};
+
+/**
+ * Register population sizes (1e2 to 1e6 terms) and scope depths as benchmark
+ * arguments.
+ */
+inline void
+population_args(benchmark::internal::Benchmark* b)
+{
+  b->ArgNames({"terms", "depth"});
+  for (int64_t n = 100; n <= 1000000; n *= 10)
+  {
+    for (int64_t depth : {1, 4, 16})
+    {
+      b->Args({n, depth});
+    }
+  }
+}
+
+/** Create a fresh BV constant of given size (a leaf term, as in Smt2Solver). */
+inline Term
+mk_const(uint32_t bv_size)
+{
+  static uint64_t n = 0;
+  return std::make_shared<smt2::Smt2Term>(
+      Op::UNDEFINED,
+      std::vector<std::string>{},
+      std::vector<Term>{},
+      std::vector<uint32_t>{},
+      "c" + std::to_string(n++) + "_" + std::to_string(bv_size));
+}
+
+/** Create a BV sort of given size. */
+inline Sort
+mk_bv_sort(uint32_t bv_size)
+{
+  return std::make_shared<smt2::Smt2Sort>(
+      "(_ BitVec " + std::to_string(bv_size) + ")", bv_size);
+}
+
+/**
+ * An offline SMT2 solver with a solver manager, set up as for a test run
+ * (but without enabling theories randomly).
+ */
+class Env
+{
+ public:
+  /**
+   * Constructor.
+   * theories: The enabled theories, all theories supported by the SMT2 solver
+   *           if empty.
+   */
+  Env(const TheoryVector& theories = {THEORY_BV})
+      : d_rng(SEED),
+        d_sng(SEED),
+        d_out(nullptr),
+        d_solver(new smt2::Smt2Solver(d_sng, d_out, "")),
+        d_profile(d_solver->get_profile()),
+        d_stats(new statistics::Statistics()),
+        d_fsm(d_rng,
+              d_sng,
+              d_solver,
+              d_profile,
+              d_out,
+              d_options,
+              false,
+              true,
+              true,
+              false,
+              "",
+              d_stats.get(),
+              theories,
+              {},
+              {},
+              true,
+              false),
+        d_smgr(d_fsm.get_smgr())
+  {
+    for (uint32_t bv_size : BV_SIZES)
+    {
+      d_sorts.push_back(mk_bv_sort(bv_size));
+    }
+  }
+
+  /**
+   * Populate given term database.
+   * Adds `depth - 1` variables (binders), each opening a new scope level, and
+   * distributes `num_terms` BV constants of the sizes in BV_SIZES uniformly
+   * over all scope levels.
+   */
+  void populate(TermDb& tdb, size_t num_terms, size_t depth)
+  {
+    for (size_t i = 1; i < depth; ++i)
+    {
+      size_t idx = i % d_sorts.size();
+      Term var   = mk_const(BV_SIZES[idx]);
+      tdb.add_var(var, d_sorts[idx], SORT_BV);
+    }
+    for (size_t i = 0; i < num_terms; ++i)
+    {
+      size_t idx   = i % d_sorts.size();
+      uint64_t lvl = i % depth;
+      Term t       = mk_const(BV_SIZES[idx]);
+      /* Level 0 is not bound by a variable and thus not given explicitly. */
+      tdb.add_term(t,
+                   d_sorts[idx],
+                   SORT_BV,
+                   {},
+                   lvl ? std::vector<uint64_t>{lvl} : std::vector<uint64_t>{});
+    }
+  }
+
+  /**
+   * Populate the term database of the solver manager.
+   * Adds `depth - 1` variables and `num_terms` BV constants via the solver
+   * manager, as done by the corresponding actions.
+   */
+  void populate(size_t num_terms, size_t depth)
+  {
+    for (size_t i = 1; i < depth; ++i)
+    {
+      size_t idx = i % d_sorts.size();
+      Term var   = mk_const(BV_SIZES[idx]);
+      d_smgr.add_var(var, d_sorts[idx], SORT_BV);
+    }
+    for (size_t i = 0; i < num_terms; ++i)
+    {
+      size_t idx = i % d_sorts.size();
+      Term t     = mk_const(BV_SIZES[idx]);
+      d_smgr.add_const(t, d_sorts[idx], SORT_BV);
+    }
+  }
+
+  RNGenerator d_rng;
+  SolverSeedGenerator d_sng;
+  /** Output stream of the solver and trace, discards everything. */
+  std::ostream d_out;
+  /** The solver, owned by the solver manager. */
+  Solver* d_solver;
+  SolverProfile d_profile;
+  SolverOptions d_options;
+  std::unique_ptr<statistics::Statistics> d_stats;
+  /** The state machine, only used to set up the solver manager. */
+  FSM d_fsm;
+  SolverManager& d_smgr;
+  /** The sorts of the generated terms, index corresponds to BV_SIZES. */
+  std::vector<Sort> d_sorts;
+};
+
+/* -------------------------------------------------------------------------- */
+
+}  // namespace bench
+}  // namespace murxla
+
+#endif
@@ -0,0 +1,197 @@
+#!/usr/bin/env python3
+###
+# Murxla: A Model-Based API Fuzzer for SMT solvers.
+#
+# This file is part of Murxla.
+#
+# Copyright (C) 2019-2022 by the authors listed in the AUTHORS file.
+#
+# See LICENSE for more information on using this software.
+##
+
+# Throughput benchmark for Murxla.
+#
+# Runs a fixed set of seeds in continuous mode for each given solver and
+# theory subset and reports the throughput of Murxla itself (runs/s,
+# actions/s), the mean trace length and the time spent in Murxla vs. the
+# solver. Results are written as JSON and can be compared against the results
+# of a previous run (baseline) to detect slowdowns.
+
+import argparse
+import json
+import os
+import subprocess
+import sys
+import tempfile
+
+# Theory subsets to benchmark, 'all' enables all theories supported by the
+# solver.
+THEORIES = {
+    'all': [],
+    'arrays': ['--arrays', '--bv'],
+    'bv': ['--bv'],
+    'dt': ['--dt'],
+    'fp': ['--fp'],
+    'ints': ['--ints'],
+    'reals': ['--reals'],
+    'strings': ['--strings'],
+    'uf': ['--uf'],
+}
+
+
+def gen_seeds(num_seeds):
+    """Generate a fixed set of seeds (independent of time and pid)."""
+    seeds = []
+    seed = 0
+    for _ in range(num_seeds):
+        seed = (seed * 6364136223846793005 + 1442695040888963407) % 2**64
+        seeds.append(seed)
+    return seeds
+
+
+def write_seeds(file_name, num_seeds):
+    """Write a seeds file for --seeds with the seeds of gen_seeds()."""
+    seeds = gen_seeds(num_seeds)
+    with open(file_name, 'w') as outfile:
+        for seed in seeds:
+            outfile.write(f'{seed:x}\n')
+    return seeds
+
+
+def run_bench(args, solver, theories, seeds_file, tmp_dir):
+    """Run Murxla on the seed set and return the final statistics record."""
+    stats_file = os.path.join(tmp_dir, 'stats.jsonl')
+    out_dir = os.path.join(tmp_dir, 'out')
+    if os.path.exists(stats_file):
+        os.remove(stats_file)
+    cmd = [
+        args.murxla, f'--{solver}', '--seeds', seeds_file, '-t',
+        str(args.time), '-j',
+        str(args.jobs), '-T', tmp_dir, '-O', out_dir, '--stats-stream',
+        stats_file, '--stats-interval', '1e9'
+    ] + theories
+    proc = subprocess.run(cmd,
+                          stdout=subprocess.DEVNULL,
+                          stderr=subprocess.PIPE)
+    if proc.returncode != 0 or not os.path.exists(stats_file):
+        err = proc.stderr.decode().strip().split('\n')[-1]
+        print(f'  skipped: {err}')
+        return None
+    with open(stats_file) as infile:
+        return json.loads(infile.readlines()[-1])
+
+
+def summarize(record):
+    """Extract the benchmark results from a final statistics record."""
+    elapsed = record['elapsed']
+    total_time = record['murxla_time'] + record['solver_time']
+    return {
+        'runs': record['runs'],
+        'runs_per_sec': record['runs'] / elapsed if elapsed else 0,
+        # The final record reports action rates over the whole run.
+        'actions_per_sec': sum(record['actions'].values()),
+        'trace_length': record['trace_length'],
+        'murxla_time': record['murxla_time'],
+        'solver_time': record['solver_time'],
+        'murxla_share':
+        record['murxla_time'] / total_time if total_time else 0,
+        'timeouts': record['timeouts'],
+        'errors': record['errors'],
+    }
+
+
+def compare(results, baseline, tolerance):
+    """Compare results against baseline, return the list of regressions."""
+    regressions = []
+    print()
+    print(f'{"benchmark":<20} {"runs/s":>10} {"baseline":>10} {"ratio":>7}')
+    for name, res in sorted(results.items()):
+        base = baseline.get(name)
+        if not base or not base['runs_per_sec']:
+            continue
+        for key in ('runs_per_sec', 'actions_per_sec'):
+            ratio = res[key] / base[key] if base[key] else 1
+            if ratio < 1 - tolerance:
+                regressions.append((name, key, ratio))
+        ratio = res['runs_per_sec'] / base['runs_per_sec']
+        print(f'{name:<20} {res["runs_per_sec"]:>10.2f} '
+              f'{base["runs_per_sec"]:>10.2f} {ratio:>7.2f}')
+    return regressions
+
+
+def main():
+    ap = argparse.ArgumentParser(description='Murxla throughput benchmark')
+    ap.add_argument('--murxla', required=True, help='the murxla binary')
+    ap.add_argument('--solvers',
+                    default='smt2',
+                    help='comma-separated list of solvers to benchmark')
+    ap.add_argument('--theories',
+                    default=','.join(THEORIES),
+                    help='comma-separated list of theory subsets')
+    ap.add_argument('--runs',
+                    type=int,
+                    default=200,
+                    help='number of test runs (seeds) per benchmark')
+    ap.add_argument('--time',
+                    type=float,
+                    default=5,
+                    help='time limit per test run')
+    ap.add_argument('--jobs',
+                    type=int,
+                    default=1,
+                    help='number of test runs to execute in parallel')
+    ap.add_argument('--output',
+                    default='murxla-bench.json',
+                    help='the file to write the results to')
+    ap.add_argument('--baseline', help='the results to compare against')
+    ap.add_argument('--tolerance',
+                    type=float,
+                    default=0.1,
+                    help='relative slowdown reported as regression')
+    args = ap.parse_args()
+
+    results = {}
+    with tempfile.TemporaryDirectory(prefix='murxla-bench-') as tmp_dir:
+        seeds_file = os.path.join(tmp_dir, 'seeds')
+        write_seeds(seeds_file, args.runs)
+
+        for solver in args.solvers.split(','):
+            for theory in args.theories.split(','):
+                name = f'{solver}/{theory}'
+                print(f'{name}:')
+                record = run_bench(args, solver, THEORIES[theory], seeds_file,
+                                   tmp_dir)
+                if record is None:
+                    continue
+                res = summarize(record)
+                results[name] = res
+                print(f'  {res["runs_per_sec"]:.2f} runs/s, '
+                      f'{res["actions_per_sec"]:.2f} actions/s, '
+                      f'trace length {res["trace_length"]:.1f}, '
+                      f'murxla {100 * res["murxla_share"]:.1f}% of '
+                      f'{res["murxla_time"] + res["solver_time"]:.2f}s')
+
+    with open(args.output, 'w') as outfile:
+        json.dump(
+            {
+                'runs': args.runs,
+                'time': args.time,
+                'jobs': args.jobs,
+                'results': results
+            },
+            outfile,
+            indent=2)
+    print(f'\nresults written to {args.output}')
+
+    if args.baseline:
+        with open(args.baseline) as infile:
+            baseline = json.load(infile)['results']
+        regressions = compare(results, baseline, args.tolerance)
+        for name, key, ratio in regressions:
+            print(f'regression: {name} {key} at {ratio:.2f} of baseline')
+        if regressions:
+            sys.exit(1)
+
+
+if __name__ == '__main__':
+    main()
@@ -163,9 +163,9 @@ ActionTermGetChildren::run(Term term)
   MURXLA_TRACE << get_kind() << " " << term;
 
   /* Call Term::get_kind(). */
-  Op::Kind kind = term->get_kind();
+  Op::Kind kind = MURXLA_API_CALL(term->get_kind());
   /* Call Term::get_children(). */
-  std::vector<Term> children = term->get_children();
+  std::vector<Term> children = MURXLA_API_CALL(term->get_children());
   /* Perform some checks based on term kind */
   if (!children.empty())
   {
@@ -235,7 +235,7 @@ ActionNew::run()
 {
   MURXLA_TRACE << get_kind();
 
-  d_solver.new_solver();
+  MURXLA_API_CALL(d_solver.new_solver());
 
   d_smgr.d_incremental       = d_solver.option_incremental_enabled();
   d_smgr.d_model_gen         = d_solver.option_model_gen_enabled();
@@ -266,7 +266,7 @@ ActionDelete::run()
 {
   MURXLA_TRACE << get_kind();
   d_smgr.clear();
-  d_solver.delete_solver();
+  MURXLA_API_CALL(d_solver.delete_solver());
 }
 
 /* -------------------------------------------------------------------------- */
@@ -376,7 +376,7 @@ void
 ActionSetLogic::run(const std::string& logic)
 {
   MURXLA_TRACE << get_kind() << " " << logic;
-  d_solver.set_logic(logic);
+  MURXLA_API_CALL(d_solver.set_logic(logic));
 }
 
 /* -------------------------------------------------------------------------- */
@@ -449,7 +449,7 @@ ActionSetOption::run(const std::string& opt, const std::string& value)
   MURXLA_TRACE << get_kind() << " " << opt << " " << value;
   try
   {
-    d_solver.set_opt(opt, value);
+    MURXLA_API_CALL(d_solver.set_opt(opt, value));
     d_smgr.d_incremental       = d_solver.option_incremental_enabled();
     d_smgr.d_model_gen         = d_solver.option_model_gen_enabled();
     d_smgr.d_unsat_assumptions = d_solver.option_unsat_assumptions_enabled();
@@ -1030,7 +1030,7 @@ std::vector<uint64_t>
 ActionMkSort::run(SortKind kind)
 {
   MURXLA_TRACE << get_kind() << " " << kind;
-  Sort res = d_solver.mk_sort(kind);
+  Sort res = MURXLA_API_CALL(d_solver.mk_sort(kind));
   d_smgr.add_sort(res, kind);
   check_sort(res);
   MURXLA_TRACE_RETURN << res;
@@ -1042,7 +1042,7 @@ ActionMkSort::run(SortKind kind, const std::string& name)
 {
   assert(kind == SORT_UNINTERPRETED);
   MURXLA_TRACE << get_kind() << " " << kind << " " << name;
-  Sort res = d_solver.mk_sort(name);
+  Sort res = MURXLA_API_CALL(d_solver.mk_sort(name));
   d_smgr.add_sort(res, kind);
   check_sort(res);
   MURXLA_TRACE_RETURN << res;
@@ -1055,7 +1055,7 @@ ActionMkSort::run(SortKind kind, uint32_t bw)
 {
   MURXLA_TRACE << get_kind() << " " << kind << " " << bw;
   assert(kind == SORT_BV);
-  Sort res = d_solver.mk_sort(kind, bw);
+  Sort res = MURXLA_API_CALL(d_solver.mk_sort(kind, bw));
   MURXLA_TEST(res->get_bv_size() == bw);
   d_smgr.add_sort(res, kind);
   check_sort(res);
@@ -1069,7 +1069,7 @@ ActionMkSort::run(SortKind kind, uint32_t ew, uint32_t sw)
 {
   MURXLA_TRACE << get_kind() << " " << kind << " " << ew << " " << sw;
   assert(kind == SORT_FP);
-  Sort res = d_solver.mk_sort(kind, ew, sw);
+  Sort res = MURXLA_API_CALL(d_solver.mk_sort(kind, ew, sw));
   MURXLA_TEST(res->get_fp_exp_size() == ew);
   MURXLA_TEST(res->get_fp_sig_size() == sw);
   d_smgr.add_sort(res, kind);
@@ -1083,7 +1083,7 @@ ActionMkSort::run(SortKind kind, const std::vector<Sort>& sorts)
 {
   MURXLA_TRACE << get_kind() << " " << kind << sorts;
   assert(sorts.size() >= 1);
-  Sort res = d_solver.mk_sort(kind, sorts);
+  Sort res = MURXLA_API_CALL(d_solver.mk_sort(kind, sorts));
   res->set_sorts(sorts);
   d_smgr.add_sort(res, kind);
   check_sort(res);
@@ -1133,8 +1133,8 @@ ActionMkSort::run(SortKind kind,
     }
   }
   MURXLA_TRACE << get_kind() << " " << kind << ss.str();
-  std::vector<Sort> res_sorts =
-      d_solver.mk_sort(kind, dt_names, param_sorts, constructors);
+  std::vector<Sort> res_sorts = MURXLA_API_CALL(
+      d_solver.mk_sort(kind, dt_names, param_sorts, constructors));
 
   std::unordered_map<std::string, Sort> symbol_to_dt_sort;
   for (size_t i = 0; i < n_dt_sorts; ++i)
@@ -1302,6 +1302,7 @@ ActionMkTerm::generate(Op::Kind kind)
   }
 
   ++d_smgr.d_mbt_stats->d_ops[op.d_id];
+  d_smgr.d_mbt_timer.set_op(op.d_id);
 
   if (kind == Op::DT_APPLY_CONS)
   {
@@ -2028,6 +2029,7 @@ ActionMkTerm::generate()
     run(kind, sort_kind, args, {});
 
     ++d_smgr.d_mbt_stats->d_ops[op.d_id];
+    d_smgr.d_mbt_timer.set_op(op.d_id);
     return true;
   }
   return generate(kind);
@@ -2149,7 +2151,7 @@ ActionMkTerm::run(Op::Kind kind,
     }
   }
 
-  Term res = d_solver.mk_term(kind, args, indices);
+  Term res = MURXLA_API_CALL(d_solver.mk_term(kind, args, indices));
   // MURXLA_TEST(res->get_sort() == nullptr
   //             || d_solver.get_sort(res, sort_kind)->equals(res->get_sort()));
 
@@ -2199,7 +2201,7 @@ ActionMkTerm::run(Op::Kind kind,
   MURXLA_TRACE << get_kind() << trace_str.str();
   reset_sat();
 
-  Term res = d_solver.mk_term(kind, str_args, args);
+  Term res = MURXLA_API_CALL(d_solver.mk_term(kind, str_args, args));
   d_smgr.add_term(res, sort_kind, args);
   Sort res_sort = res->get_sort();
 
@@ -2236,7 +2238,7 @@ ActionMkTerm::run(Op::Kind kind,
     }
   }
 
-  Term res = d_solver.mk_term(kind, sort, str_args, args);
+  Term res = MURXLA_API_CALL(d_solver.mk_term(kind, sort, str_args, args));
   /* We do not add match case terms since they are specifically created for
    * creating a match term and should not be used in any other terms. */
   d_smgr.add_term(res, sort_kind, args);
@@ -2511,7 +2513,7 @@ ActionMkConst::run(Sort sort, const std::string& symbol)
 {
   MURXLA_TRACE << get_kind() << " " << sort << " \"" << symbol << "\"";
   reset_sat();
-  Term res = d_solver.mk_const(sort, symbol);
+  Term res = MURXLA_API_CALL(d_solver.mk_const(sort, symbol));
   d_smgr.add_const(res, sort, sort->get_kind());
   MURXLA_TRACE_RETURN << res;
   check_const(d_rng, res);
@@ -2574,7 +2576,7 @@ std::vector<uint64_t>
 ActionMkVar::run(Sort sort, const std::string& symbol)
 {
   MURXLA_TRACE << get_kind() << " " << sort << " \"" << symbol << "\"";
-  Term res = d_solver.mk_var(sort, symbol);
+  Term res = MURXLA_API_CALL(d_solver.mk_var(sort, symbol));
   d_smgr.add_var(res, sort, sort->get_kind());
   MURXLA_TRACE_RETURN << res;
   check_variable(d_rng, res);
@@ -2770,7 +2772,7 @@ ActionMkValue::run(Sort sort, bool val)
 {
   MURXLA_TRACE << get_kind() << " " << sort << " " << (val ? "true" : "false");
   reset_sat();
-  Term res = d_solver.mk_value(sort, val);
+  Term res = MURXLA_API_CALL(d_solver.mk_value(sort, val));
   d_smgr.add_value(res, sort, sort->get_kind());
   MURXLA_TRACE_RETURN << res;
   check_value(res);
@@ -2783,7 +2785,7 @@ ActionMkValue::run(Sort sort, const std::string& val)
   MURXLA_TRACE << get_kind() << " " << sort << " \"" << val << "\"";
   reset_sat();
   Term res;
-  res = d_solver.mk_value(sort, val);
+  res = MURXLA_API_CALL(d_solver.mk_value(sort, val));
   d_smgr.add_value(res, sort, sort->get_kind());
   MURXLA_TRACE_RETURN << res;
   check_value(res);
@@ -2795,7 +2797,7 @@ ActionMkValue::run(Sort sort, const std::string& val, size_t len)
 {
   MURXLA_TRACE << get_kind() << " " << sort << " \"" << val << "\"";
   reset_sat();
-  Term res = d_solver.mk_value(sort, val);
+  Term res = MURXLA_API_CALL(d_solver.mk_value(sort, val));
   d_smgr.add_value(res, sort, sort->get_kind());
   if (len == 1)
   {
@@ -2813,7 +2815,7 @@ ActionMkValue::run(Sort sort, const std::string& v0, const std::string& v1)
   MURXLA_TRACE << get_kind() << " " << sort << " \"" << v0 << "\""
                << " \"" << v1 << "\"";
   reset_sat();
-  Term res = d_solver.mk_value(sort, v0, v1);
+  Term res = MURXLA_API_CALL(d_solver.mk_value(sort, v0, v1));
   d_smgr.add_value(res, sort, sort->get_kind());
   MURXLA_TRACE_RETURN << res;
   check_value(res);
@@ -2826,7 +2828,7 @@ ActionMkValue::run(Sort sort, const std::string& val, Solver::Base base)
   MURXLA_TRACE << get_kind() << " " << sort << " \"" << val << "\""
                << " " << base;
   reset_sat();
-  Term res = d_solver.mk_value(sort, val, base);
+  Term res = MURXLA_API_CALL(d_solver.mk_value(sort, val, base));
   d_smgr.add_value(res, sort, sort->get_kind());
   MURXLA_TRACE_RETURN << res;
   check_value(res);
@@ -2949,7 +2951,7 @@ ActionMkSpecialValue::run(Sort sort, const AbsTerm::SpecialValueKind& val)
 {
   MURXLA_TRACE << get_kind() << " " << sort << " \"" << val << "\"";
   Term res;
-  res = d_solver.mk_special_value(sort, val);
+  res = MURXLA_API_CALL(d_solver.mk_special_value(sort, val));
   d_smgr.add_value(res, sort, sort->get_kind(), val);
   MURXLA_TRACE_RETURN << res;
   check_special_value(d_rng, res, val);
@@ -3114,7 +3116,7 @@ ActionInstantiateSort::run(
         cache,
     std::vector<std::pair<std::string, Sort>>& to_trace)
 {
-  Sort res = d_solver.instantiate_sort(param_sort, sorts);
+  Sort res = MURXLA_API_CALL(d_solver.instantiate_sort(param_sort, sorts));
   res->set_dt_is_instantiated(true);
   MURXLA_TEST(param_sort->is_dt_parametric());
   /* We temporarily set the ctors map to the map of param_sort in order to be
@@ -3210,7 +3212,7 @@ ActionAssertFormula::run(Term assertion)
 {
   MURXLA_TRACE << get_kind() << " " << assertion;
   reset_sat();
-  d_solver.assert_formula(assertion);
+  MURXLA_API_CALL(d_solver.assert_formula(assertion));
 }
 //! [docs-action-assertformula-run end]
 
@@ -3244,7 +3246,7 @@ ActionCheckSat::run()
 {
   MURXLA_TRACE << get_kind();
   reset_sat();
-  d_smgr.report_result(d_solver.check_sat());
+  d_smgr.report_result(MURXLA_API_CALL(d_solver.check_sat()));
 }
 
 /* -------------------------------------------------------------------------- */
@@ -3298,7 +3300,8 @@ ActionCheckSatAssuming::run(const std::vector<Term>& assumptions)
   {
     d_smgr.add_assumption(t);
   }
-  d_smgr.report_result(d_solver.check_sat_assuming(assumptions));
+  d_smgr.report_result(
+      MURXLA_API_CALL(d_solver.check_sat_assuming(assumptions)));
 }
 
 /* -------------------------------------------------------------------------- */
@@ -3337,7 +3340,7 @@ ActionGetUnsatAssumptions::run()
 {
   MURXLA_TRACE << get_kind();
   /* Note: Unsat assumptions are checked in the checker solver. */
-  (void) d_solver.get_unsat_assumptions();
+  (void) MURXLA_API_CALL(d_solver.get_unsat_assumptions());
 }
 
 /* -------------------------------------------------------------------------- */
@@ -3371,7 +3374,7 @@ ActionGetUnsatCore::run()
   MURXLA_TRACE << get_kind();
   /* Note: The Terms in this vector are solver terms wrapped into Term,
    *       without sort information! */
-  std::vector<Term> res = d_solver.get_unsat_core();
+  std::vector<Term> res = MURXLA_API_CALL(d_solver.get_unsat_core());
 }
 
 /* -------------------------------------------------------------------------- */
@@ -3431,7 +3434,7 @@ ActionGetValue::run(const std::vector<Term>& terms)
   MURXLA_TRACE << get_kind() << " " << terms.size() << terms;
   /* Note: The Terms in this vector are solver terms wrapped into Term,
    *       without sort information! */
-  (void) d_solver.get_value(terms);
+  (void) MURXLA_API_CALL(d_solver.get_value(terms));
 }
 
 /* -------------------------------------------------------------------------- */
@@ -3464,7 +3467,7 @@ ActionPush::run(uint32_t n_levels)
 {
   MURXLA_TRACE << get_kind() << " " << n_levels;
   reset_sat();
-  d_solver.push(n_levels);
+  MURXLA_API_CALL(d_solver.push(n_levels));
   d_smgr.d_n_push_levels += n_levels;
 }
 
@@ -3499,7 +3502,7 @@ ActionPop::run(uint32_t n_levels)
 {
   MURXLA_TRACE << get_kind() << " " << n_levels;
   reset_sat();
-  d_solver.pop(n_levels);
+  MURXLA_API_CALL(d_solver.pop(n_levels));
   d_smgr.d_n_push_levels -= n_levels;
 }
 
@@ -3526,7 +3529,7 @@ ActionReset::run()
 {
   MURXLA_TRACE << get_kind();
   d_smgr.reset();
-  d_solver.reset();
+  MURXLA_API_CALL(d_solver.reset());
 }
 
 /* -------------------------------------------------------------------------- */
@@ -3552,7 +3555,7 @@ ActionResetAssertions::run()
 {
   MURXLA_TRACE << get_kind();
   reset_sat();
-  d_solver.reset_assertions();
+  MURXLA_API_CALL(d_solver.reset_assertions());
   d_smgr.d_n_push_levels = 0;
 }
 
@@ -3585,7 +3588,7 @@ void
 ActionPrintModel::run()
 {
   MURXLA_TRACE << get_kind();
-  d_solver.print_model();
+  MURXLA_API_CALL(d_solver.print_model());
 }
 
 /* -------------------------------------------------------------------------- */
@@ -3732,7 +3735,7 @@ ActionMkFun::run(const std::string& name,
   s->set_sorts(sorts);
 
   // Create function and set sort.
-  Term res = d_solver.mk_fun(name, args, body);
+  Term res = MURXLA_API_CALL(d_solver.mk_fun(name, args, body));
   // We don't perform this check for now until the SMT2 solver can correctly
   // handle this case.
   // MURXLA_TEST(d_solver.get_sort(res, SORT_FUN)->equals(s));
@@ -15,6 +15,7 @@
 #include <string>
 #include <vector>
 
+#include "interned_string.hpp"
 #include "solver/solver.hpp"
 
 /* -------------------------------------------------------------------------- */
@@ -68,6 +69,20 @@
       & Action::TraceStream(d_smgr).stream() << std::setw(6) << " " \
                                              << "return "
 
+/**
+ * The macro to be used for executing the solver API call of an action.
+ *
+ * The call is timed as time spent in the solver, everything else an action
+ * does (generating and tracing the call, updating the solver manager,
+ * checking the result) is timed as time spent in Murxla (see
+ * statistics::ActionTimer). Evaluates to the result of the call, e.g.,
+ * ```
+ * Sort res = MURXLA_API_CALL(d_solver.mk_sort(kind));
+ * ```
+ */
+#define MURXLA_API_CALL(call) \
+  d_smgr.d_mbt_timer.time_api_call([&]() -> decltype(auto) { return call; })
+
 /* -------------------------------------------------------------------------- */
 
 namespace murxla {
@@ -98,9 +113,10 @@ class Action
    *
    * This is used as action identifier when tracing.
    * We further use strings here to make FSM::d_actions easily extensible
-   * with solver-specific actions.
+   * with solver-specific actions. Strings are interned into dense ids
+   * (see InternedString) for cheap comparison and hashing.
    */
-  using Kind = std::string;
+  using Kind = InternedString<Action>;
 
   /** The undefined action. */
   inline static const Kind UNDEFINED = "undefined";
@@ -119,6 +119,20 @@
 #define MURXLA_MK_FUN_MAX_ARGS 5
 #define MURXLA_MK_FUN_MAX_TERMS 32
 
+/**
+ * The scale of the adaptive weights of actions, relative to their static
+ * weights (see State::run()).
+ */
+#define MURXLA_ADAPTIVE_WEIGHT_SCALE 64
+/**
+ * The minimum adaptive weight of an action, relative to its static weight,
+ * to keep actions that rarely succeed explorable.
+ */
+#define MURXLA_ADAPTIVE_WEIGHT_MIN 4
+
+/** Maximum number of mutations applied to an API trace in mutation mode. */
+#define MURXLA_MAX_N_MUTATIONS 4
+
 #define MURXLA_CHECK_SOLVER_OPT_PREFIX "murxla-check-solver:"
 
 #endif
@@ -0,0 +1,202 @@
+/***
+ * Murxla: A Model-Based API Fuzzer for SMT solvers.
+ *
+ * This file is part of Murxla.
+ *
+ * Copyright (C) 2019-2022 by the authors listed in the AUTHORS file.
+ *
+ * See LICENSE for more information on using this software.
+ */
+#include "coverage.hpp"
+
+#include <sys/mman.h>
+
+#include <cassert>
+#include <cstring>
+#include <new>
+
+#include "except.hpp"
+
+/* The coverage callbacks must not be instrumented themselves. */
+#if defined(__clang__)
+#define MURXLA_NO_COVERAGE __attribute__((no_sanitize("coverage")))
+#elif defined(__GNUC__) && __GNUC__ >= 12
+#define MURXLA_NO_COVERAGE __attribute__((no_sanitize_coverage))
+#else
+#define MURXLA_NO_COVERAGE
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+namespace {
+
+/** The map the edges of the current process are recorded into, if any. */
+uint8_t* s_map = nullptr;
+/** The number of guards registered via trace-pc-guard. */
+uint32_t s_num_guards = 0;
+
+}  // namespace
+
+extern "C" {
+
+MURXLA_NO_COVERAGE void
+__sanitizer_cov_trace_pc_guard_init(uint32_t* start, uint32_t* stop)
+{
+  /* Guards of a module may be initialized more than once. Guard index 0 is
+   * reserved for uninitialized guards. */
+  if (start == stop || *start) return;
+  for (uint32_t* guard = start; guard < stop; ++guard)
+  {
+    *guard = static_cast<uint32_t>(
+        1 + s_num_guards++ % (murxla::CoverageMap::MAP_SIZE - 1));
+  }
+}
+
+MURXLA_NO_COVERAGE void
+__sanitizer_cov_trace_pc_guard(uint32_t* guard)
+{
+  uint8_t* map = s_map;
+  if (map) map[*guard] = 1;
+}
+
+MURXLA_NO_COVERAGE void
+__sanitizer_cov_trace_pc()
+{
+  uint8_t* map = s_map;
+  if (map)
+  {
+    uint64_t pc = reinterpret_cast<uintptr_t>(__builtin_return_address(0));
+    map[(pc ^ (pc >> 20)) % murxla::CoverageMap::MAP_SIZE] = 1;
+  }
+}
+}
+
+namespace murxla {
+
+/* -------------------------------------------------------------------------- */
+
+CoverageMap::CoverageMap(size_t num_workers, size_t num_runs)
+    : d_num_workers(num_workers),
+      d_num_runs(num_runs),
+      d_size(sizeof(Header) + sizeof(RunInfo) * num_workers * num_runs
+             + MAP_SIZE * (num_workers + 1))
+{
+  void* m = mmap(nullptr,
+                 d_size,
+                 PROT_WRITE | PROT_READ,
+                 MAP_SHARED | MAP_ANONYMOUS,
+                 -1,
+                 0);
+  MURXLA_EXIT_ERROR(m == MAP_FAILED) << "failed to allocate coverage map";
+  d_header    = new (m) Header();
+  d_run_infos = reinterpret_cast<RunInfo*>(static_cast<char*>(m)
+                                           + sizeof(Header));
+  for (size_t i = 0, n = num_workers * num_runs; i < n; ++i)
+  {
+    new (&d_run_infos[i]) RunInfo();
+  }
+  d_maps = reinterpret_cast<uint8_t*>(d_run_infos + num_workers * num_runs);
+}
+
+CoverageMap::~CoverageMap()
+{
+  /* Stop recording if the current process records into this map. */
+  if (s_map >= d_maps && s_map < d_maps + MAP_SIZE * (d_num_workers + 1))
+  {
+    s_map = nullptr;
+  }
+  munmap(d_header, d_size);
+}
+
+void
+CoverageMap::reset(size_t worker)
+{
+  assert(worker < d_num_workers);
+  for (size_t i = 0; i < d_num_runs; ++i)
+  {
+    RunInfo& info    = d_run_infos[worker * d_num_runs + i];
+    info.d_new_edges = 0;
+    info.d_theories  = 0;
+  }
+}
+
+CoverageMap::RunInfo&
+CoverageMap::start_run(size_t worker, size_t run)
+{
+  assert(run < d_num_runs);
+  uint8_t* map = get_run_map(worker);
+  memset(map, 0, MAP_SIZE);
+  s_map = map;
+  return d_run_infos[worker * d_num_runs + run];
+}
+
+uint32_t
+CoverageMap::merge(size_t worker)
+{
+  const uint64_t* run = reinterpret_cast<uint64_t*>(get_run_map(worker));
+  uint64_t* global    = reinterpret_cast<uint64_t*>(d_maps);
+  uint32_t res        = 0;
+  /* Compare word-wise, most words of the run map are zero. The global map is
+   * merged into concurrently by all workers, an edge is only counted by the
+   * worker that set it first. Edges are marked with byte value 1, the new
+   * bits of a word thus correspond to newly covered edges. */
+  for (size_t i = 0, n = MAP_SIZE / sizeof(uint64_t); i < n; ++i)
+  {
+    if (run[i] == 0
+        || (run[i] & ~__atomic_load_n(&global[i], __ATOMIC_RELAXED)) == 0)
+    {
+      continue;
+    }
+    uint64_t old = __atomic_fetch_or(&global[i], run[i], __ATOMIC_RELAXED);
+    res += static_cast<uint32_t>(__builtin_popcountll(run[i] & ~old));
+  }
+  d_header->d_num_edges += res;
+  return res;
+}
+
+const CoverageMap::RunInfo&
+CoverageMap::get_run_info(size_t worker, size_t run) const
+{
+  assert(worker < d_num_workers);
+  assert(run < d_num_runs);
+  return d_run_infos[worker * d_num_runs + run];
+}
+
+uint64_t
+CoverageMap::get_num_edges() const
+{
+  return d_header->d_num_edges;
+}
+
+uint8_t*
+CoverageMap::get_run_map(size_t worker) const
+{
+  assert(worker < d_num_workers);
+  return d_maps + MAP_SIZE * (worker + 1);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void
+SeedCorpus::add(uint64_t seed, uint64_t theories, uint32_t new_edges)
+{
+  assert(new_edges > 0);
+  d_entries.push_back({seed, theories, new_edges});
+  d_energy.push_back(new_edges);
+}
+
+const SeedCorpus::Entry&
+SeedCorpus::pick(RNGenerator& rng)
+{
+  assert(!empty());
+  size_t idx   = rng.pick_weighted<size_t>(d_energy.begin(), d_energy.end());
+  Entry& entry = d_entries[idx];
+  entry.d_num_picked += 1;
+  d_energy[idx] =
+      static_cast<double>(entry.d_new_edges) / (1 + entry.d_num_picked);
+  return entry;
+}
+
+/* -------------------------------------------------------------------------- */
+
+}  // namespace murxla
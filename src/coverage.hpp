@@ -0,0 +1,162 @@
+/***
+ * Murxla: A Model-Based API Fuzzer for SMT solvers.
+ *
+ * This file is part of Murxla.
+ *
+ * Copyright (C) 2019-2022 by the authors listed in the AUTHORS file.
+ *
+ * See LICENSE for more information on using this software.
+ */
+#ifndef __MURXLA__COVERAGE_H
+#define __MURXLA__COVERAGE_H
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "rng.hpp"
+
+namespace murxla {
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * Edge coverage of the solver under test in shared memory.
+ *
+ * Solvers compiled with `-fsanitize-coverage=trace-pc-guard` (Clang) or
+ * `-fsanitize-coverage=trace-pc` (GCC) call back into Murxla on every edge,
+ * which is recorded into the run map of the worker the current process
+ * belongs to. At the end of a test run, the worker process merges its run
+ * map into the global map, which contains all edges covered so far, and
+ * reports the number of newly covered edges of the run to the parent.
+ *
+ * Edges are identified by guard index (trace-pc-guard) or by a hash of the
+ * program counter (trace-pc), modulo the map size.
+ */
+class CoverageMap
+{
+ public:
+  /** The number of edges (bytes) of a map. */
+  static constexpr size_t MAP_SIZE = 1 << 20;
+
+  /** The coverage information of a test run, written by the worker. */
+  struct RunInfo
+  {
+    /** The number of edges that were covered first by this test run. */
+    std::atomic<uint32_t> d_new_edges;
+    /** The enabled theories of the test run (bit mask over Theory). */
+    std::atomic<uint64_t> d_theories;
+  };
+
+  /**
+   * Constructor.
+   * num_workers: The number of workers.
+   * num_runs   : The maximum number of test runs per worker process.
+   */
+  CoverageMap(size_t num_workers, size_t num_runs);
+  /** Destructor. */
+  ~CoverageMap();
+
+  CoverageMap(const CoverageMap&) = delete;
+  CoverageMap& operator=(const CoverageMap&) = delete;
+
+  /**
+   * Reset the information of all test runs of given worker.
+   * Called by the parent before starting a new worker process.
+   */
+  void reset(size_t worker);
+  /**
+   * Start recording the edges of the current process into the (cleared) run
+   * map of given worker. Called by the worker process before each test run.
+   * Returns the information of the test run to be filled in by the worker.
+   */
+  RunInfo& start_run(size_t worker, size_t run);
+  /**
+   * Merge the run map of given worker into the global map.
+   * Called by the worker process after each test run, concurrently with the
+   * processes of other workers.
+   * Returns the number of edges that were not covered before, edges that are
+   * covered by test runs of multiple workers are only counted once.
+   */
+  uint32_t merge(size_t worker);
+
+  /** Get the information of given test run of given worker. */
+  const RunInfo& get_run_info(size_t worker, size_t run) const;
+  /** Get the number of covered edges of all test runs so far. */
+  uint64_t get_num_edges() const;
+
+ private:
+  /** The header of the shared memory region. */
+  struct Header
+  {
+    /** The number of covered edges in the global map. */
+    std::atomic<uint64_t> d_num_edges;
+  };
+
+  /** Get the run map of given worker. */
+  uint8_t* get_run_map(size_t worker) const;
+
+  /** The number of workers. */
+  size_t d_num_workers;
+  /** The maximum number of test runs per worker process. */
+  size_t d_num_runs;
+  /** The size of the shared memory region in bytes. */
+  size_t d_size;
+  /** The header of the shared memory region. */
+  Header* d_header = nullptr;
+  /** The information of the test runs, `d_num_runs` per worker. */
+  RunInfo* d_run_infos = nullptr;
+  /** The global map, followed by one run map per worker. */
+  uint8_t* d_maps = nullptr;
+};
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * The corpus of test runs that covered new edges.
+ *
+ * Entries are picked with a probability proportional to their energy, which
+ * is the number of new edges they covered, decayed by the number of times
+ * they were picked already.
+ */
+class SeedCorpus
+{
+ public:
+  /** An entry of the corpus. */
+  struct Entry
+  {
+    /** The seed of the test run. */
+    uint64_t d_seed;
+    /** The enabled theories of the test run (bit mask over Theory). */
+    uint64_t d_theories;
+    /** The number of edges that were covered first by the test run. */
+    uint32_t d_new_edges;
+    /** The number of times this entry was picked. */
+    uint32_t d_num_picked = 0;
+  };
+
+  /** Add entry for given test run. */
+  void add(uint64_t seed, uint64_t theories, uint32_t new_edges);
+  /**
+   * Pick an entry based on its energy.
+   * Requires that the corpus is not empty.
+   */
+  const Entry& pick(RNGenerator& rng);
+
+  /** Return true if the corpus is empty. */
+  bool empty() const { return d_entries.empty(); }
+  /** Get the number of entries. */
+  size_t size() const { return d_entries.size(); }
+
+ private:
+  /** The entries of the corpus. */
+  std::vector<Entry> d_entries;
+  /** The energy of the entries, used as weights when picking. */
+  std::vector<double> d_energy;
+};
+
+/* -------------------------------------------------------------------------- */
+
+}  // namespace murxla
+
+#endif
@@ -0,0 +1,134 @@
+/***
+ * Murxla: A Model-Based API Fuzzer for SMT solvers.
+ *
+ * This file is part of Murxla.
+ *
+ * Copyright (C) 2019-2022 by the authors listed in the AUTHORS file.
+ *
+ * See LICENSE for more information on using this software.
+ */
+#include "error_index.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <iterator>
+#include <sstream>
+
+namespace murxla {
+
+/* -------------------------------------------------------------------------- */
+
+ErrorIndex::Error::Error(const std::string& msg) : d_msg(msg)
+{
+  std::istringstream buf(msg);
+  d_tokens.assign(std::istream_iterator<std::string>(buf),
+                  std::istream_iterator<std::string>());
+  for (const auto& t : d_tokens)
+  {
+    /* Numbers are ignored for the difference of tokens. */
+    d_weights.push_back(std::count_if(
+        t.begin(), t.end(), [](char c) { return !std::isdigit(c); }));
+  }
+}
+
+/* -------------------------------------------------------------------------- */
+
+size_t
+ErrorIndex::add(const std::string& err)
+{
+  size_t id = d_errors.size();
+  d_errors.emplace_back(err);
+  d_ids.emplace(err, id);
+  d_buckets[get_bucket(err.size())][d_errors.back().d_tokens.size()]
+      .push_back(id);
+  return id;
+}
+
+std::optional<size_t>
+ErrorIndex::find(const std::string& err) const
+{
+  /* Identical messages are similar (unless empty). */
+  if (!err.empty())
+  {
+    auto it = d_ids.find(err);
+    if (it != d_ids.end())
+    {
+      return it->second;
+    }
+  }
+
+  Error e(err);
+
+  /* The difference of two errors is at least the difference of their number
+   * of tokens, errors with a number of tokens outside of this range (relative
+   * to the length of the longer error) can not be similar. */
+  size_t num_tokens = e.d_tokens.size();
+  for (const auto& [bucket, errors] : d_buckets)
+  {
+    size_t max_len = std::max(err.size(), (size_t{1} << bucket) - 1);
+    size_t range   =
+        static_cast<size_t>(MAX_DIFF * static_cast<double>(max_len)) + 1;
+    auto lower =
+        errors.lower_bound(num_tokens > range ? num_tokens - range : 0);
+    auto upper = errors.upper_bound(num_tokens + range);
+
+    for (auto it = lower; it != upper; ++it)
+    {
+      for (size_t id : it->second)
+      {
+        if (is_similar(e, d_errors[id]))
+        {
+          return id;
+        }
+      }
+    }
+  }
+  return std::nullopt;
+}
+
+bool
+ErrorIndex::is_similar(const Error& e1, const Error& e2)
+{
+  size_t len = std::max(e1.d_msg.size(), e2.d_msg.size());
+  if (len == 0)
+  {
+    return false;
+  }
+
+  const Error* t1 = &e1;
+  const Error* t2 = &e2;
+  if (t1->d_tokens.size() > t2->d_tokens.size())
+  {
+    std::swap(t1, t2);
+  }
+
+  auto similar = [len](size_t diff) {
+    return static_cast<double>(diff) / static_cast<double>(len) <= MAX_DIFF;
+  };
+
+  /* Stop comparing as soon as the errors are not similar anymore. */
+  size_t diff = t2->d_tokens.size() - t1->d_tokens.size();
+  for (size_t i = 0, n = t1->d_tokens.size(); i < n && similar(diff); ++i)
+  {
+    if (t1->d_tokens[i] != t2->d_tokens[i])
+    {
+      diff += t1->d_weights[i];
+    }
+  }
+  return similar(diff);
+}
+
+size_t
+ErrorIndex::get_bucket(size_t len)
+{
+  size_t bucket = 0;
+  for (; len; len >>= 1)
+  {
+    ++bucket;
+  }
+  return bucket;
+}
+
+/* -------------------------------------------------------------------------- */
+
+}  // namespace murxla
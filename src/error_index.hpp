@@ -0,0 +1,97 @@
+/***
+ * Murxla: A Model-Based API Fuzzer for SMT solvers.
+ *
+ * This file is part of Murxla.
+ *
+ * Copyright (C) 2019-2022 by the authors listed in the AUTHORS file.
+ *
+ * See LICENSE for more information on using this software.
+ */
+#ifndef __MURXLA__ERROR_INDEX_H
+#define __MURXLA__ERROR_INDEX_H
+
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace murxla {
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * Index of error messages for finding similar errors.
+ *
+ * Two errors are classified as the same error if they differ in at most 5% of
+ * characters. Error messages are compared token-wise, where the number of
+ * non-digit characters of differing tokens (of the error with fewer tokens)
+ * plus the difference in the number of tokens is counted as the difference.
+ *
+ * Messages are tokenized once when added to the index. Since two errors that
+ * differ in more tokens than 5% of characters of the longer error can never
+ * be similar, errors are grouped by their length into buckets of lengths
+ * [2^(b-1), 2^b), and within a bucket by their number of tokens. Per bucket,
+ * only errors with a number of tokens within the tolerance w.r.t. the
+ * length of the queried error and the maximum length of the bucket are
+ * compared against. Identical messages are found via hashing.
+ */
+class ErrorIndex
+{
+ public:
+  /** The maximum difference of similar errors relative to their length. */
+  static constexpr double MAX_DIFF = 0.05;
+
+  /**
+   * Add error message to the index.
+   * Returns the id of the error, ids are consecutive starting from 0.
+   */
+  size_t add(const std::string& err);
+
+  /**
+   * Find an error in the index that is similar to the given error.
+   * Returns the id of the error, or std::nullopt if there is no such error.
+   */
+  std::optional<size_t> find(const std::string& err) const;
+
+  /** Get the error message with given id. */
+  const std::string& get(size_t id) const { return d_errors[id].d_msg; }
+
+  /** Return the number of errors in the index. */
+  size_t size() const { return d_errors.size(); }
+
+ private:
+  /** A tokenized error message. */
+  struct Error
+  {
+    Error(const std::string& msg);
+    /** The error message. */
+    std::string d_msg;
+    /** The tokens of the message. */
+    std::vector<std::string> d_tokens;
+    /** The number of non-digit characters of each token. */
+    std::vector<size_t> d_weights;
+  };
+
+  /** Return true if given errors are similar. */
+  static bool is_similar(const Error& e1, const Error& e2);
+  /** Return the length bucket of an error message of given length. */
+  static size_t get_bucket(size_t len);
+
+  /** The errors in the index, indexed by id. */
+  std::vector<Error> d_errors;
+  /** Maps error message to id. */
+  std::unordered_map<std::string, size_t> d_ids;
+  /**
+   * Maps length bucket to a map from number of tokens to ids of errors with
+   * that number of tokens.
+   */
+  std::map<size_t, std::map<size_t, std::vector<size_t>>> d_buckets;
+};
+
+/* -------------------------------------------------------------------------- */
+
+}  // namespace murxla
+
+#endif
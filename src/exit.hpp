@@ -18,6 +18,7 @@ enum ExitCode
   EXIT_ERROR,
   EXIT_ERROR_CONFIG,
   EXIT_ERROR_UNTRACE,
+  EXIT_MEMOUT,
 };
 }
 #endif
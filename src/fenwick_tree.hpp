@@ -0,0 +1,124 @@
+/***
+ * Murxla: A Model-Based API Fuzzer for SMT solvers.
+ *
+ * This file is part of Murxla.
+ *
+ * Copyright (C) 2019-2022 by the authors listed in the AUTHORS file.
+ *
+ * See LICENSE for more information on using this software.
+ */
+#ifndef __MURXLA__FENWICK_TREE_H
+#define __MURXLA__FENWICK_TREE_H
+
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+namespace murxla {
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * Fenwick tree (binary indexed tree) over a growable sequence of values.
+ *
+ * Supports appending and removing values at the end, updating values, prefix
+ * sums and searching for a prefix in O(log n). Arithmetic is performed in T,
+ * unsigned types thus wrap around on negative deltas, which is fine as long as
+ * all (prefix) sums are non-negative.
+ */
+template <typename T>
+class FenwickTree
+{
+ public:
+  /** Get the number of values. */
+  size_t size() const { return d_tree.size(); }
+  /** Return true if the tree holds no values. */
+  bool empty() const { return d_tree.empty(); }
+  /** Remove all values. */
+  void clear() { d_tree.clear(); }
+
+  /** Append given value. */
+  void push_back(T value)
+  {
+    /* Node i (1-based) holds the sum of the values in (i - lowbit(i), i]. */
+    size_t i = d_tree.size() + 1;
+    d_tree.push_back(value + prefix(i - 1) - prefix(i - (i & -i)));
+  }
+  /** Remove the last value. No other node covers the last value. */
+  void pop_back()
+  {
+    assert(!d_tree.empty());
+    d_tree.pop_back();
+  }
+
+  /** Add given delta to the value at index `idx`. */
+  void add(size_t idx, T delta)
+  {
+    assert(idx < d_tree.size());
+    for (size_t i = idx + 1, n = d_tree.size(); i <= n; i += i & -i)
+    {
+      d_tree[i - 1] += delta;
+    }
+  }
+  /** Get the value at index `idx`. */
+  T get(size_t idx) const { return sum(idx, idx + 1); }
+  /** Set the value at index `idx`. */
+  void set(size_t idx, T value) { add(idx, value - get(idx)); }
+
+  /** Get the sum of the values in [0, end). */
+  T prefix(size_t end) const
+  {
+    assert(end <= d_tree.size());
+    T res = 0;
+    for (size_t i = end; i > 0; i -= i & -i)
+    {
+      res += d_tree[i - 1];
+    }
+    return res;
+  }
+  /** Get the sum of the values in [begin, end). */
+  T sum(size_t begin, size_t end) const
+  {
+    assert(begin <= end);
+    return prefix(end) - prefix(begin);
+  }
+  /** Get the sum of all values. */
+  T total() const { return prefix(d_tree.size()); }
+
+  /**
+   * Search for the longest prefix that is accepted by given function.
+   *
+   * The prefix is extended by blocks of consecutive values, from large to
+   * small blocks. Function `accept(len, sum)` is called with the number of
+   * values `len` of the next block and their sum `sum`, and returns true if
+   * the prefix is to be extended by that block. For a monotone criterion
+   * (e.g., the prefix sum does not exceed a given value), the result is
+   * the length of the longest prefix that satisfies the criterion.
+   */
+  template <typename F>
+  size_t find(F&& accept) const
+  {
+    size_t n    = d_tree.size();
+    size_t step = 1;
+    while (step <= n / 2) step <<= 1;
+    size_t pos = 0;
+    for (; n > 0 && step > 0; step >>= 1)
+    {
+      if (pos + step <= n && accept(step, d_tree[pos + step - 1]))
+      {
+        pos += step;
+      }
+    }
+    return pos;
+  }
+
+ private:
+  /** The nodes of the tree, node i (1-based) is stored at index i - 1. */
+  std::vector<T> d_tree;
+};
+
+/* -------------------------------------------------------------------------- */
+
+}  // namespace murxla
+
+#endif
@@ -56,7 +56,10 @@ State::run(RNGenerator& rng)
 {
   MURXLA_CHECK_CONFIG(!d_actions.empty()) << "no actions configured";
 
-  uint32_t idx      = rng.pick_weighted<uint32_t>(d_weights);
+  uint32_t idx =
+      d_adaptive ? rng.pick_weighted<uint32_t>(d_adaptive_weights.begin(),
+                                               d_adaptive_weights.end())
+                 : rng.pick_weighted<uint32_t>(d_weights);
   ActionTuple& atup = d_actions[idx];
 
   /* record state statistics */
@@ -68,28 +71,58 @@ State::run(RNGenerator& rng)
   ++d_mbt_stats->d_actions[atup.d_action->get_id()];
 
   /* run action */
+  uint64_t progress =
+      d_adaptive ? d_smgr_stats->sorts + d_smgr_stats->op_sorts : 0;
   atup.d_action->seed_solver_rng();
-  if (atup.d_action->generate()
-      && (atup.d_next->f_precond == nullptr || atup.d_next->f_precond()))
-  {
-    /* record action statistics */
-    ++d_mbt_stats->d_actions_ok[atup.d_action->get_id()];
+  d_mbt_timer->start();
+  bool success = atup.d_action->generate();
+  d_mbt_timer->stop(d_mbt_stats, atup.d_action->get_id());
+  success = success
+            && (atup.d_next->f_precond == nullptr || atup.d_next->f_precond());
 
-    return d_actions[idx].d_next;
-  }
   /* Disable action if generate() will always return false for this run.
    * This happens e.g., when incremental is disabled and check-sat was already
    * called, then it doesn't make sense to call check-sat again in this run.
    * The disable flag is set dynamically for an action based on certain
    * conditions in the current run. */
-  else if (atup.d_action->disabled())
+  if (!success && atup.d_action->disabled())
   {
     d_weights[idx] = 0;
   }
 
+  if (d_adaptive)
+  {
+    d_num_runs[idx] += 1;
+    d_num_ok[idx] += success;
+    d_num_progress[idx] +=
+        d_smgr_stats->sorts + d_smgr_stats->op_sorts != progress;
+    d_adaptive_weights[idx] = compute_adaptive_weight(idx);
+  }
+
+  if (success)
+  {
+    /* record action statistics */
+    ++d_mbt_stats->d_actions_ok[atup.d_action->get_id()];
+
+    return d_actions[idx].d_next;
+  }
+
   return this;
 }
 
+uint64_t
+State::compute_adaptive_weight(size_t idx) const
+{
+  /* The static weight, scaled by the success ratio of the action with a
+   * bonus for progress (Laplace-smoothed, at most twice the success ratio),
+   * and bounded from below to keep the action explorable. */
+  uint64_t weight = d_weights[idx];
+  uint64_t res    = weight * MURXLA_ADAPTIVE_WEIGHT_SCALE
+                 * (1 + d_num_ok[idx] + d_num_progress[idx])
+                 / (2 + d_num_runs[idx]);
+  return std::max<uint64_t>(res, weight * MURXLA_ADAPTIVE_WEIGHT_MIN);
+}
+
 /* -------------------------------------------------------------------------- */
 /* FSM                                                                        */
 /* -------------------------------------------------------------------------- */
@@ -109,7 +142,8 @@ FSM::FSM(RNGenerator& rng,
          const TheoryVector& enabled_theories,
          const TheorySet& disabled_theories,
          const std::vector<std::pair<std::string, std::string>> solver_options,
-         bool in_untrace_replay_mode)
+         bool in_untrace_replay_mode,
+         bool adaptive_weights)
     : d_smgr(solver,
              solver_profile,
              rng,
@@ -126,12 +160,13 @@ FSM::FSM(RNGenerator& rng,
       d_smtlib_compliant(smtlib_compliant),
       d_fuzz_options(fuzz_options),
       d_fuzz_options_filter(fuzz_options_filter),
+      d_adaptive_weights(adaptive_weights),
       d_mbt_stats(stats),
       d_solver_options(solver_options),
       d_solver_profile(solver_profile)
 {
   auto smgr_enabled_theories = d_smgr.get_enabled_theories();
-  auto unsupported_theory_combinations =
+  const auto& unsupported_theory_combinations =
       d_solver_profile.get_unsupported_theory_combinations();
 
   for (const auto& [theory, theory_list] : unsupported_theory_combinations)
@@ -224,6 +259,8 @@ FSM::new_state(const State::Kind& kind,
   state = d_states.back().get();
   state->set_id(id);
   state->d_mbt_stats = d_mbt_stats;
+  state->d_mbt_timer = &d_smgr.d_mbt_timer;
+  state->d_smgr_stats = &d_smgr.d_stats;
   strncpy(d_mbt_stats->d_state_kinds[id], kind.c_str(), kind.size());
 
   return state;
@@ -548,7 +585,7 @@ FSM::configure()
   {
     Action* action                                  = std::get<0>(t);
     uint32_t priority                               = std::get<1>(t);
-    std::unordered_set<std::string> excluded_states = std::get<2>(t);
+    std::unordered_set<State::Kind> excluded_states = std::get<2>(t);
     State* next                                     = std::get<3>(t);
     for (const auto& s : d_states)
     {
@@ -574,7 +611,7 @@ FSM::configure()
     Action* action                                  = std::get<0>(t);
     uint32_t priority                               = std::get<1>(t);
     State* state                                    = std::get<2>(t);
-    std::unordered_set<std::string> excluded_states = std::get<3>(t);
+    std::unordered_set<State::Kind> excluded_states = std::get<3>(t);
     for (const auto& s : d_states)
     {
       if (s->d_ignore) continue;
@@ -607,6 +644,24 @@ FSM::configure()
       w = sum / w;
     }
   }
+
+  /* Initialize adaptive weights. */
+  if (d_adaptive_weights)
+  {
+    for (const auto& s : d_states)
+    {
+      size_t n = s->d_actions.size();
+      s->d_adaptive = true;
+      s->d_num_runs.assign(n, 0);
+      s->d_num_ok.assign(n, 0);
+      s->d_num_progress.assign(n, 0);
+      s->d_adaptive_weights.resize(n);
+      for (size_t i = 0; i < n; ++i)
+      {
+        s->d_adaptive_weights[i] = s->compute_adaptive_weight(i);
+      }
+    }
+  }
 }
 
 void
@@ -671,21 +726,25 @@ FSM::untrace(const std::string& trace_file_name)
 {
   assert(!trace_file_name.empty());
 
+  std::ifstream trace(trace_file_name);
+  MURXLA_CHECK_CONFIG(trace.is_open())
+      << "untrace: unable to open file '" << trace_file_name << "'";
+  untrace(trace, trace_file_name);
+}
+
+void
+FSM::untrace(std::istream& trace, const std::string& trace_file_name)
+{
   uint32_t nline   = 0;
   std::vector<uint64_t> ret_val;
   Action* ret_action;
   std::string line;
-  std::ifstream trace;
   bool sng_untrace_mode = d_smgr.get_sng().is_untrace_mode();
 
   /* Set mode to untracing. We keep the untraced solver seeds when untracing
    * and do not generate new solver seeds. */
   d_smgr.get_sng().set_untrace_mode(true);
 
-  trace.open(trace_file_name);
-  MURXLA_CHECK_CONFIG(trace.is_open())
-      << "untrace: unable to open file '" << trace_file_name << "'";
-
   try
   {
     while (std::getline(trace, line))
@@ -828,7 +887,6 @@ FSM::untrace(const std::string& trace_file_name)
   {
     throw MurxlaUntraceException(trace_file_name, nline, e.get_msg());
   }
-  if (trace.is_open()) trace.close();
 
   /* reset to previous mode */
   d_smgr.get_sng().set_untrace_mode(sng_untrace_mode);
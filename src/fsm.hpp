@@ -22,6 +22,7 @@
 #include "action.hpp"
 #include "config.hpp"
 #include "except.hpp"
+#include "interned_string.hpp"
 #include "solver_manager.hpp"
 #include "solver_option.hpp"
 #include "statistics.hpp"
@@ -83,9 +84,10 @@ class State
    * This is used a state identifier when retrieving states that have been
    * added to the FSM via FSM::get_state().
    * We use strings here to make the set of state kinds easily extensible
-   * with solver-specific states.
+   * with solver-specific states. Strings are interned into dense ids
+   * (see InternedString) for cheap comparison and hashing.
    */
-  using Kind = std::string;
+  using Kind = InternedString<State>;
 
   /** The undefined state. */
   inline static const Kind UNDEFINED = "undefined";
@@ -257,6 +259,11 @@ class State
    * with this state. Transitions with higher weight, are picked with a higher
    * probability.
    *
+   * If adaptive weights are enabled, the weight of a transition is scaled by
+   * the success ratio of its action in this state, with a bonus for each
+   * time the action made progress, i.e., created new sorts or terms of a new
+   * combination of operator and sort kind.
+   *
    * @param rng  The associated random number generator.
    * @return  The next state.
    */
@@ -283,6 +290,9 @@ class State
   void disable_action(Action::Kind kind);
 
  private:
+  /** Compute the adaptive weight of the action at given index. */
+  uint64_t compute_adaptive_weight(size_t idx) const;
+
   /** State kind. */
   const Kind& d_kind;
 
@@ -309,8 +319,26 @@ class State
   /** The weights of the actions associated with this state. */
   std::vector<uint32_t> d_weights;
 
+  /** True if the weights of the actions adapt to their success ratio. */
+  bool d_adaptive = false;
+  /**
+   * The adaptive weights of the actions associated with this state, only
+   * used if d_adaptive is true.
+   */
+  std::vector<uint64_t> d_adaptive_weights;
+  /** The number of times each action was run in this state. */
+  std::vector<uint32_t> d_num_runs;
+  /** The number of times each action succeeded in this state. */
+  std::vector<uint32_t> d_num_ok;
+  /** The number of times each action made progress in this state. */
+  std::vector<uint32_t> d_num_progress;
+  /** The solver manager statistics used to determine progress. */
+  const SolverManager::Stats* d_smgr_stats = nullptr;
+
   /** The associated statistics object. */
   statistics::Statistics* d_mbt_stats;
+  /** The associated timer for action times. */
+  statistics::ActionTimer* d_mbt_timer;
 };
 
 /**
@@ -398,7 +426,8 @@ class FSM
       const TheoryVector& enabled_theories,
       const TheorySet& disabled_theories,
       const std::vector<std::pair<std::string, std::string>> solver_options,
-      bool in_untrace_replay_mode);
+      bool in_untrace_replay_mode,
+      bool adaptive_weights);
 
   /** Default constructor is disabled. */
   FSM() = delete;
@@ -463,7 +492,7 @@ class FSM
    * @param fun   The precondition for transitioning into the state.
    * @return  The created decision state.
    */
-  State* new_decision_state(const std::string& kind,
+  State* new_decision_state(const State::Kind& kind,
                             std::function<bool(void)> fun = nullptr);
 
   /**
@@ -483,7 +512,7 @@ class FSM
    * @param fun   The precondition for transitioning into the state.
    * @return  The created choice state.
    */
-  State* new_choice_state(const std::string& kind,
+  State* new_choice_state(const State::Kind& kind,
                           std::function<bool(void)> fun = nullptr,
                           bool is_final                 = false);
   /**
@@ -499,7 +528,7 @@ class FSM
    * @param fun   The precondition for transitioning into the state.
    * @return  The created choice state.
    */
-  State* new_final_state(const std::string& kind,
+  State* new_final_state(const State::Kind& kind,
                          std::function<bool(void)> fun = nullptr);
 
   /** Create new action of given type T. */
@@ -533,7 +562,7 @@ class FSM
   void add_action_to_all_states(
       T* action,
       uint32_t priority,
-      const std::unordered_set<std::string>& excluded_states = {},
+      const std::unordered_set<State::Kind>& excluded_states = {},
       State* next                                            = nullptr);
 
   /**
@@ -561,7 +590,7 @@ class FSM
       T* action,
       uint32_t priority,
       State* state,
-      const std::unordered_set<std::string>& excluded_states = {});
+      const std::unordered_set<State::Kind>& excluded_states = {});
 
   /** Set given state as initial state. */
   void set_init_state(State* init_state);
@@ -575,6 +604,12 @@ class FSM
   void configure();
   /** Replay given trace. */
   void untrace(const std::string& trace_file_name);
+  /**
+   * Replay trace from given input stream.
+   * trace          : The input stream to read the trace from.
+   * trace_file_name: The name of the trace, used in error messages.
+   */
+  void untrace(std::istream& trace, const std::string& trace_file_name);
 
   /** Print the current configuration of this FSM to stdout. */
   void print() const;
@@ -612,7 +647,7 @@ class FSM
    * The state kinds always to exclude when adding actions to all states
    * (add_action_to_all_states) or when adding all aconfigured states to an
    * action/transition (add_action_to_all_states_next). */
-  std::unordered_set<std::string> d_actions_all_states_excluded = {
+  std::unordered_set<State::Kind> d_actions_all_states_excluded = {
       State::NEW, State::DELETE, State::OPT, State::OPT_REQ, State::SET_LOGIC};
 
   /** The initial state. */
@@ -628,6 +663,8 @@ class FSM
   bool d_fuzz_options = false;
   /** Filter options to be fuzzed. */
   std::string d_fuzz_options_filter;
+  /** True to adapt the weights of actions during a run. */
+  bool d_adaptive_weights = false;
 
   statistics::Statistics* d_mbt_stats;
 
@@ -0,0 +1,146 @@
+/***
+ * Murxla: A Model-Based API Fuzzer for SMT solvers.
+ *
+ * This file is part of Murxla.
+ *
+ * Copyright (C) 2019-2022 by the authors listed in the AUTHORS file.
+ *
+ * See LICENSE for more information on using this software.
+ */
+#ifndef __MURXLA__INTERNED_STRING_H
+#define __MURXLA__INTERNED_STRING_H
+
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace murxla {
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * A string that is interned into a dense integer id.
+ *
+ * Each distinct string is assigned an id on its first use, ids are dense and
+ * assigned in order of first use, separately for each Tag. Comparison and
+ * hashing only consider the id, which makes interned strings cheap keys for
+ * maps and allows to index arrays by id. The string itself is kept for
+ * tracing and printing.
+ *
+ * The empty string is always assigned id 0.
+ */
+template <typename Tag>
+class InternedString
+{
+ public:
+  /** Construct the interned empty string. */
+  InternedString() : d_id(0) {}
+  /** Construct interned string from given string. */
+  InternedString(const char* str) : d_id(intern(str)) {}
+  /** Construct interned string from given string. */
+  InternedString(const std::string& str) : d_id(intern(str)) {}
+
+  /** Get the id of this string. */
+  uint32_t get_id() const { return d_id; }
+  /** Get the string. */
+  const std::string& str() const { return get_string(d_id); }
+  /** Get the string. */
+  operator const std::string&() const { return str(); }
+  /** Get the string as C string. */
+  const char* c_str() const { return str().c_str(); }
+  /** Get the length of the string. */
+  size_t size() const { return str().size(); }
+  /** Return true if this is the empty string. */
+  bool empty() const { return d_id == 0; }
+
+  friend bool operator==(const InternedString& a, const InternedString& b)
+  {
+    return a.d_id == b.d_id;
+  }
+  friend bool operator!=(const InternedString& a, const InternedString& b)
+  {
+    return a.d_id != b.d_id;
+  }
+  friend bool operator<(const InternedString& a, const InternedString& b)
+  {
+    return a.str() < b.str();
+  }
+  friend std::ostream& operator<<(std::ostream& out, const InternedString& s)
+  {
+    return out << s.str();
+  }
+
+  /** Get the number of interned strings, an upper bound for all ids. */
+  static size_t get_num_ids() { return get_table().d_strings.size(); }
+  /** Get the string with given id. */
+  static const std::string& get_string(uint32_t id)
+  {
+    assert(id < get_num_ids());
+    return *get_table().d_strings[id];
+  }
+
+ private:
+  /** The interned strings of this Tag. */
+  struct Table
+  {
+    Table() { intern(""); }
+    /** Get the id of given string, assign the next id if it is new. */
+    uint32_t intern(const std::string& str)
+    {
+      auto [it, inserted] =
+          d_ids.emplace(str, static_cast<uint32_t>(d_strings.size()));
+      if (inserted)
+      {
+        /* Keys of the map are not moved on rehashing. */
+        d_strings.push_back(&it->first);
+      }
+      return it->second;
+    }
+    /** Maps strings to ids. */
+    std::unordered_map<std::string, uint32_t> d_ids;
+    /** Maps ids to strings. */
+    std::vector<const std::string*> d_strings;
+  };
+
+  /**
+   * Get the table of interned strings. Interned strings are created during
+   * static initialization (e.g., kind constants), the table is thus
+   * initialized on first use.
+   */
+  static Table& get_table()
+  {
+    static Table table;
+    return table;
+  }
+  /** Intern given string. */
+  static uint32_t intern(const std::string& str)
+  {
+    return get_table().intern(str);
+  }
+
+  /** The id of this string. */
+  uint32_t d_id;
+};
+
+/* -------------------------------------------------------------------------- */
+
+}  // namespace murxla
+
+namespace std {
+
+template <typename Tag>
+struct hash<murxla::InternedString<Tag>>
+{
+  size_t operator()(const murxla::InternedString<Tag>& str) const
+  {
+    return str.get_id();
+  }
+};
+
+}  // namespace std
+
+#endif
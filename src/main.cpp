@@ -16,6 +16,7 @@
 #include <sys/wait.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <cstdlib>
 #include <ctime>
 #include <filesystem>
@@ -48,15 +49,19 @@ static bool g_errors_print_csv = false;
 
 /* -------------------------------------------------------------------------- */
 
+/**
+ * Allocate given number of statistics shards in shared memory.
+ * Anonymous mappings are zero-initialized, pages of shards are thus only
+ * allocated when statistics are recorded into them.
+ */
 static Statistics*
-initialize_statistics()
+initialize_statistics(uint32_t num_shards)
 {
-  void *m = mmap(NULL, sizeof(Statistics), PROT_WRITE|PROT_READ, MAP_SHARED|MAP_ANONYMOUS, -1, 0);
+  void *m = mmap(NULL, sizeof(Statistics) * num_shards, PROT_WRITE|PROT_READ, MAP_SHARED|MAP_ANONYMOUS, -1, 0);
   if (m == MAP_FAILED) {
     perror("mmap failed");
     exit(1);
   }
-  memset(m, 0, sizeof(Statistics));
 
   return static_cast<Statistics*>(m);
 }
@@ -119,7 +124,13 @@ print_error_summary()
         std::cout << "\"" << escape_csv(e_info.errmsg) << "\",";
         for (auto seed : e_info.seeds)
         {
-          std::cout << std::hex << seed << " ";
+          std::cout << std::hex << seed << std::dec;
+          auto it = e_info.seed_options.find(seed);
+          if (it != e_info.seed_options.end())
+          {
+            std::cout << " (" << it->second << ")";
+          }
+          std::cout << " ";
         }
         std::cout << std::endl;
       }
@@ -138,6 +149,11 @@ print_error_summary()
             std::cout << " ";
           }
           std::cout << std::hex << e_info.seeds[i] << std::dec;
+          auto it = e_info.seed_options.find(e_info.seeds[i]);
+          if (it != e_info.seed_options.end())
+          {
+            std::cout << " (" << it->second << ")";
+          }
         }
         std::cout << "\n" << e_info.errmsg << "\n" << std::endl;
       }
@@ -152,23 +168,17 @@ print_error_summary()
 /* Signal handler for printing error summary. */
 static void (*sig_int_handler_esummary)(int32_t);
 
+/**
+ * Only interrupts the continuous testing campaign, which saves its state and
+ * returns. The error summary is then printed and the signal is raised again
+ * by interrupted(). A second signal is handled by the original handler.
+ */
 static void
 catch_signal_esummary(int32_t sig)
 {
-  static int32_t caught_signal = 0;
-  if (!caught_signal)
-  {
-    print_error_summary();
-    caught_signal = sig;
-  }
-  if (std::filesystem::exists(TMP_DIR))
-  {
-    std::filesystem::remove_all(TMP_DIR);
-  }
-
+  (void) sig;
+  Murxla::interrupt();
   (void) signal(SIGINT, sig_int_handler_esummary);
-  raise(sig);
-  exit(EXIT_ERROR);
 }
 
 static void
@@ -177,6 +187,19 @@ set_sigint_handler_stats(void)
   sig_int_handler_esummary = signal(SIGINT, catch_signal_esummary);
 }
 
+/** Print the error summary, clean up and terminate via SIGINT. */
+static void
+interrupted(void)
+{
+  print_error_summary();
+  if (std::filesystem::exists(TMP_DIR))
+  {
+    std::filesystem::remove_all(TMP_DIR);
+  }
+  raise(SIGINT);
+  exit(EXIT_ERROR);
+}
+
 /* -------------------------------------------------------------------------- */
 /* Help message                                                               */
 /* -------------------------------------------------------------------------- */
@@ -192,15 +215,30 @@ set_sigint_handler_stats(void)
   "  -O, --out-dir <dir>        write output files to given directory\n"       \
   "  -l, --smt-lib              generate SMT-LIB compliant traces only\n"      \
   "  -y, --random-symbols       use random symbol names\n"                     \
+  "  --adaptive-weights         adapt action weights to their success ratio\n" \
   "  --stats                    print statistics\n"                            \
   "  --print-fsm                print FSM configuration, may be combined\n"    \
   "                             with solver option to show config for \n"      \
   "\n"                                                                         \
   " Continuous mode options:\n"                                                \
   "  -t, --time <double>        time limit per test run\n"                     \
+  "  --adaptive-time            adapt time limit to observed run times\n"      \
+  "  --memory-limit <int>       memory limit per test run in MB\n"             \
   "  -m, --max-runs <int>       limit number of test runs\n"                   \
+  "  --seeds <file>             only run the seeds (hex) listed in <file>\n"   \
+  "  -j, --jobs <int>           number of test runs to execute in parallel\n"  \
+  "  --persistent <int>         execute up to <int> test runs per process\n"   \
+  "  --coverage-guided          bias test runs towards new solver coverage\n"  \
+  "  --mutate <path>            mutate the API traces in file or dir <path>\n" \
   "  --csv                      print error summary in csv format\n"           \
   "  -e, --export-errors <out>  export found errors to JSON file <out>\n"      \
+  "  --checkpoint <file>        periodically save testing state to <file>\n"   \
+  "  --checkpoint-interval <double>\n"                                         \
+  "                             interval for --checkpoint in seconds\n"        \
+  "  --resume                   resume testing from --checkpoint <file>\n"     \
+  "  --stats-stream <target>    stream statistics as JSON lines to <target>\n" \
+  "                             (file, or unix:<path> for a Unix socket)\n"    \
+  "  --stats-interval <double>  interval for --stats-stream in seconds\n"      \
   "\n"                                                                         \
   " One-shot mode options:\n"                                                  \
   "  -s, --seed <int>           seed for random number generator\n"            \
@@ -469,6 +507,10 @@ parse_options(Options& options, int argc, char* argv[])
     {
       options.simple_symbols = false;
     }
+    else if (arg == "--adaptive-weights")
+    {
+      options.adaptive_weights = true;
+    }
     else if (arg == "-T" || arg == "--tmp-dir")
     {
       i += 1;
@@ -564,16 +606,86 @@ parse_options(Options& options, int argc, char* argv[])
       check_next_arg(arg, i, size);
       options.export_errors_filename = args[i];
     }
+    else if (arg == "--adaptive-time")
+    {
+      options.adaptive_time = true;
+    }
+    else if (arg == "--coverage-guided")
+    {
+      options.coverage_guided = true;
+    }
+    else if (arg == "--mutate")
+    {
+      i += 1;
+      check_next_arg(arg, i, size);
+      options.mutation_corpus = args[i];
+    }
+    else if (arg == "--memory-limit")
+    {
+      i += 1;
+      check_next_arg(arg, i, size);
+      options.memory_limit = std::stoull(args[i]);
+    }
+    else if (arg == "--checkpoint")
+    {
+      i += 1;
+      check_next_arg(arg, i, size);
+      options.checkpoint_file_name = args[i];
+    }
+    else if (arg == "--checkpoint-interval")
+    {
+      i += 1;
+      check_next_arg(arg, i, size);
+      options.checkpoint_interval = std::atof(args[i].c_str());
+    }
+    else if (arg == "--resume")
+    {
+      options.resume = true;
+    }
+    else if (arg == "--stats-stream")
+    {
+      i += 1;
+      check_next_arg(arg, i, size);
+      options.stats_stream = args[i];
+    }
+    else if (arg == "--stats-interval")
+    {
+      i += 1;
+      check_next_arg(arg, i, size);
+      options.stats_interval = std::atof(args[i].c_str());
+    }
     else if (arg == "--solver-trace")
     {
       options.solver_trace = true;
     }
+    else if (arg == "--seeds")
+    {
+      i += 1;
+      check_next_arg(arg, i, size);
+      options.seeds_file_name = args[i];
+    }
     else if (arg == "-m" || arg == "--max-runs")
     {
       i += 1;
       check_next_arg(arg, i, size);
       options.max_runs = (uint32_t) std::stoul(args[i]);
     }
+    else if (arg == "-j" || arg == "--jobs")
+    {
+      i += 1;
+      check_next_arg(arg, i, size);
+      options.jobs = (uint32_t) std::stoul(args[i]);
+      MURXLA_EXIT_ERROR(options.jobs == 0)
+          << "number of jobs must be greater than 0";
+    }
+    else if (arg == "--persistent")
+    {
+      i += 1;
+      check_next_arg(arg, i, size);
+      options.persistent_runs = (uint32_t) std::stoul(args[i]);
+      MURXLA_EXIT_ERROR(options.persistent_runs == 0)
+          << "number of test runs per process must be greater than 0";
+    }
     else if (arg == "-l" || arg == "--smt-lib")
     {
       options.smtlib_compliant = true;
@@ -710,6 +822,11 @@ parse_options(Options& options, int argc, char* argv[])
     options.solver = SOLVER_SMT2;
   }
 
+  MURXLA_EXIT_ERROR(options.adaptive_time && options.time <= 0)
+      << "option --adaptive-time requires a time limit given via -t";
+  MURXLA_EXIT_ERROR(options.resume && options.checkpoint_file_name.empty())
+      << "option --resume requires a checkpoint file given via --checkpoint";
+
   if (options.solver == SOLVER_SMT2)
   {
     options.check_solver      = false;
@@ -738,12 +855,15 @@ parse_options(Options& options, int argc, char* argv[])
 int
 main(int argc, char* argv[])
 {
-  statistics::Statistics* stats = initialize_statistics();
   SolverOptions solver_options;
   Options options;
 
   parse_options(options, argc, argv);
 
+  /* One statistics shard for the main process and one per worker. */
+  uint32_t num_stats            = std::max(options.jobs, 1u) + 1;
+  statistics::Statistics* stats = initialize_statistics(num_stats);
+
   bool is_untrace    = !options.untrace_file_name.empty();
   bool is_continuous = !options.is_seeded && !is_untrace;
   bool is_forked     = options.dd || is_continuous;
@@ -758,7 +878,8 @@ main(int argc, char* argv[])
 
   try
   {
-    Murxla murxla(stats, options, &solver_options, &g_errors, TMP_DIR);
+    Murxla murxla(
+        stats, num_stats, options, &solver_options, &g_errors, TMP_DIR);
 
     if (options.print_fsm)
     {
@@ -770,6 +891,10 @@ main(int argc, char* argv[])
     {
       set_sigint_handler_stats();
       murxla.test();
+      if (Murxla::is_interrupted())
+      {
+        interrupted();
+      }
     }
     else
     {
@@ -838,10 +963,15 @@ main(int argc, char* argv[])
 
   if (options.print_stats)
   {
-    stats->print();
+    auto total = std::make_unique<Statistics>();
+    for (uint32_t i = 0; i < num_stats; ++i)
+    {
+      total->merge(stats[i]);
+    }
+    total->print();
   }
 
-  MURXLA_EXIT_ERROR(munmap(stats, sizeof(Statistics)))
+  MURXLA_EXIT_ERROR(munmap(stats, sizeof(Statistics) * num_stats))
       << "failed to unmap shared memory for statistics";
 
   if (std::filesystem::exists(TMP_DIR))
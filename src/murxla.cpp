@@ -9,19 +9,24 @@
  */
 #include "murxla.hpp"
 
-#include <fcntl.h>
 #include <signal.h>
-#include <sys/stat.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
 #include <sys/wait.h>
 #include <unistd.h>
 
+#include <algorithm>
+#include <deque>
 #include <filesystem>
 #include <fstream>
 #include <iomanip>
+#include <new>
 #include <nlohmann/json.hpp>
 #include <regex>
+#include <sstream>
 
 #include "dd.hpp"
+#include "error_index.hpp"
 #include "except.hpp"
 #include "fsm.hpp"
 #include "solver/btor/btor_solver.hpp"
@@ -33,6 +38,7 @@
 #include "solver/solver_profile.hpp"
 #include "solver/yices/yices_solver.hpp"
 #include "statistics.hpp"
+#include "stats_stream.hpp"
 #include "util.hpp"
 
 namespace murxla {
@@ -69,72 +75,455 @@ namespace {
 std::string
 normalize_asan_error(const std::string& s)
 {
-  std::vector<std::string> regex = {"0x[0-9a-fA-F]+", "==[0-9]+=="};
+  static const std::vector<std::regex> regex = {
+      std::regex("0x[0-9a-fA-F]+"), std::regex("==[0-9]+==")};
 
   std::string res, cur_s(s);
   for (const auto& re : regex)
   {
     res.clear();
-    std::regex_replace(std::back_inserter(res),
-                       cur_s.begin(),
-                       cur_s.end(),
-                       std::regex(re),
-                       "");
+    std::regex_replace(
+        std::back_inserter(res), cur_s.begin(), cur_s.end(), re, "");
     cur_s = res;
   }
 
   return res;
 }
 
+/** The interval in seconds for checking the mailboxes of workers. */
+const double MAILBOX_POLL_INTERVAL = 0.01;
+
+/**
+ * The probability (in per mille) that a test run of coverage-guided testing
+ * uses the configuration of a corpus entry.
+ */
+const uint32_t COVERAGE_GUIDED_PROB = 500;
+
+/** Convert given set of theories to a bit mask over Theory. */
+uint64_t
+theories_to_mask(const TheorySet& theories)
+{
+  static_assert(THEORY_ALL < 64);
+  uint64_t res = 0;
+  for (Theory t : theories)
+  {
+    res |= uint64_t(1) << t;
+  }
+  return res;
+}
+
+/** Convert given bit mask over Theory to a vector of theories. */
+TheoryVector
+mask_to_theories(uint64_t mask)
+{
+  TheoryVector res;
+  for (int32_t t = 0; t < THEORY_ALL; ++t)
+  {
+    if (mask & (uint64_t(1) << t))
+    {
+      res.push_back(static_cast<Theory>(t));
+    }
+  }
+  return res;
+}
+
+/**
+ * Get the command line options that enable exactly the given theories.
+ * THEORY_BOOL is always enabled and has no option.
+ */
+std::string
+theories_to_options(const TheoryVector& theories)
+{
+  std::stringstream ss;
+  for (Theory theory : theories)
+  {
+    switch (theory)
+    {
+      case THEORY_ARRAY: ss << " --arrays"; break;
+      case THEORY_BAG: ss << " --bags"; break;
+      case THEORY_BV: ss << " --bv"; break;
+      case THEORY_DT: ss << " --dt"; break;
+      case THEORY_FP: ss << " --fp"; break;
+      case THEORY_INT: ss << " --ints"; break;
+      case THEORY_QUANT: ss << " --quant"; break;
+      case THEORY_REAL: ss << " --reals"; break;
+      case THEORY_SEQ: ss << " --seq"; break;
+      case THEORY_SET: ss << " --sets"; break;
+      case THEORY_STRING: ss << " --strings"; break;
+      case THEORY_TRANSCENDENTAL: ss << " --trans"; break;
+      case THEORY_UF: ss << " --uf"; break;
+      default: assert(theory == THEORY_BOOL);
+    }
+  }
+  std::string res = ss.str();
+  return res.empty() ? res : res.substr(1);
+}
+
+/**
+ * Add the statistics of the test runs so far to a record of the statistics
+ * stream: results of check-sat calls, number of hits per error id, the mean
+ * number of actions per test run, the total time spent in Murxla and in
+ * solver API calls, and the throughput of actions (per second) since the
+ * previous record.
+ * record      : The record to add the statistics to.
+ * stats       : The statistics.
+ * errors      : The errors found so far.
+ * num_runs    : The number of test runs so far.
+ * last_actions: The action counts at the time of the previous record,
+ *               updated to the current counts.
+ * interval    : The time in seconds since the previous record.
+ */
+void
+add_stats_to_record(nlohmann::json& record,
+                    const statistics::Statistics& stats,
+                    const Murxla::ErrorMap& errors,
+                    uint32_t num_runs,
+                    std::vector<uint64_t>& last_actions,
+                    double interval)
+{
+  record["sat"]     = stats.d_results[Solver::Result::SAT];
+  record["unsat"]   = stats.d_results[Solver::Result::UNSAT];
+  record["unknown"] = stats.d_results[Solver::Result::UNKNOWN];
+  record["errors"]  = errors.size();
+
+  nlohmann::json& hits = record["error_hits"] = nlohmann::json::object();
+  for (const auto& [e_norm, e_info] : errors)
+  {
+    hits[std::to_string(e_info.id)] = e_info.seeds.size();
+  }
+
+  uint64_t num_actions = 0, gen_time = 0, api_time = 0;
+  nlohmann::json& actions = record["actions"] = nlohmann::json::object();
+  for (uint32_t i = 0; i < MURXLA_MAX_N_ACTIONS && stats.d_action_kinds[i][0];
+       ++i)
+  {
+    num_actions += stats.d_actions[i];
+    gen_time += stats.d_action_gen_time[i].d_sum;
+    api_time += stats.d_action_api_time[i].d_sum;
+    uint64_t n = stats.d_actions[i] - last_actions[i];
+    actions[stats.d_action_kinds[i]] =
+        interval > 0 ? static_cast<double>(n) / interval : 0;
+    last_actions[i] = stats.d_actions[i];
+  }
+  record["trace_length"] =
+      num_runs ? static_cast<double>(num_actions) / num_runs : 0;
+  record["murxla_time"] = static_cast<double>(gen_time) / 1000000000;
+  record["solver_time"] = static_cast<double>(api_time) / 1000000000;
+}
+
+/**
+ * The version of the checkpoint file format. Bump on incompatible changes,
+ * fields added later are read with defaults.
+ */
+const uint32_t CHECKPOINT_VERSION = 2;
+
+/** True if the continuous testing campaign was interrupted. */
+volatile sig_atomic_t s_interrupted = 0;
+
+/** Convert histogram to JSON. */
+template <uint32_t SUB_BITS>
+nlohmann::json
+histogram_to_json(const statistics::LogHistogram<SUB_BITS>& hist)
+{
+  return {hist.d_count, hist.d_sum, hist.d_max, hist.d_buckets};
+}
+
+/** Restore histogram from JSON created by histogram_to_json(). */
+template <uint32_t SUB_BITS>
+void
+histogram_from_json(const nlohmann::json& j,
+                    statistics::LogHistogram<SUB_BITS>& hist)
+{
+  const auto& buckets = j.at(3);
+  hist.d_count        = j.at(0);
+  hist.d_sum          = j.at(1);
+  hist.d_max          = j.at(2);
+  for (size_t i = 0; i < buckets.size() && i < hist.NUM_BUCKETS; ++i)
+  {
+    hist.d_buckets[i] = buckets[i];
+  }
+}
+
 /**
- * Split string into tokens.
+ * Convert statistics to JSON.
+ * Only kinds that were registered by a test run are included.
  */
-std::vector<std::string>
-str_tokenize(const std::string& s)
+nlohmann::json
+statistics_to_json(const statistics::Statistics& stats)
 {
-  std::istringstream buf(s);
-  std::vector<std::string> ret{std::istream_iterator<std::string>(buf),
-                               std::istream_iterator<std::string>()};
-  return ret;
+  nlohmann::json res;
+  res["results"] = stats.d_results;
+  for (uint32_t i = 0; i < MURXLA_MAX_N_STATES && stats.d_state_kinds[i][0];
+       ++i)
+  {
+    res["states"].push_back({stats.d_state_kinds[i], stats.d_states[i]});
+  }
+  for (uint32_t i = 0; i < MURXLA_MAX_N_ACTIONS && stats.d_action_kinds[i][0];
+       ++i)
+  {
+    res["actions"].push_back({stats.d_action_kinds[i],
+                              stats.d_actions[i],
+                              stats.d_actions_ok[i],
+                              histogram_to_json(stats.d_action_gen_time[i]),
+                              histogram_to_json(stats.d_action_api_time[i])});
+  }
+  for (uint32_t i = 0; i < MURXLA_MAX_N_OPS && stats.d_op_kinds[i][0]; ++i)
+  {
+    res["ops"].push_back({stats.d_op_kinds[i],
+                          stats.d_ops[i],
+                          stats.d_ops_ok[i],
+                          histogram_to_json(stats.d_op_gen_time[i]),
+                          histogram_to_json(stats.d_op_api_time[i])});
+  }
+  for (uint32_t i = 0; i < SORT_ANY; ++i)
+  {
+    res["sorts"].push_back({stats.d_sorts[i], stats.d_sorts_ok[i]});
+  }
+  res["cpu_time"] = histogram_to_json(stats.d_cpu_time);
+  res["max_rss"]  = histogram_to_json(stats.d_max_rss);
+  return res;
 }
 
 /**
- * Count the number of non-digit characters two strings differ in.
+ * Restore statistics from JSON created by statistics_to_json().
+ * Kinds are restored at the index they were registered at, test runs of the
+ * same configuration register kinds at the same index.
  */
-size_t
-str_diff(const std::string& s1, const std::string& s2)
+void
+statistics_from_json(const nlohmann::json& j, statistics::Statistics& stats)
 {
-  size_t diff;
-  auto t1 = str_tokenize(s1);
-  auto t2 = str_tokenize(s2);
+  auto set_kind = [](char* kind, const std::string& s) {
+    strncpy(kind, s.c_str(), MURXLA_MAX_KIND_LEN - 1);
+  };
+
+  for (size_t i = 0; i < 3; ++i)
+  {
+    stats.d_results[i] = j.at("results").at(i);
+  }
+  const auto& states = j.value("states", nlohmann::json::array());
+  for (size_t i = 0; i < states.size() && i < MURXLA_MAX_N_STATES; ++i)
+  {
+    set_kind(stats.d_state_kinds[i], states[i].at(0));
+    stats.d_states[i] = states[i].at(1);
+  }
+  const auto& actions = j.value("actions", nlohmann::json::array());
+  for (size_t i = 0; i < actions.size() && i < MURXLA_MAX_N_ACTIONS; ++i)
+  {
+    set_kind(stats.d_action_kinds[i], actions[i].at(0));
+    stats.d_actions[i]    = actions[i].at(1);
+    stats.d_actions_ok[i] = actions[i].at(2);
+    histogram_from_json(actions[i].at(3), stats.d_action_gen_time[i]);
+    histogram_from_json(actions[i].at(4), stats.d_action_api_time[i]);
+  }
+  const auto& ops = j.value("ops", nlohmann::json::array());
+  for (size_t i = 0; i < ops.size() && i < MURXLA_MAX_N_OPS; ++i)
+  {
+    set_kind(stats.d_op_kinds[i], ops[i].at(0));
+    stats.d_ops[i]    = ops[i].at(1);
+    stats.d_ops_ok[i] = ops[i].at(2);
+    histogram_from_json(ops[i].at(3), stats.d_op_gen_time[i]);
+    histogram_from_json(ops[i].at(4), stats.d_op_api_time[i]);
+  }
+  const auto& sorts = j.value("sorts", nlohmann::json::array());
+  for (size_t i = 0; i < sorts.size() && i < SORT_ANY; ++i)
+  {
+    stats.d_sorts[i]    = sorts[i].at(0);
+    stats.d_sorts_ok[i] = sorts[i].at(1);
+  }
+  histogram_from_json(j.at("cpu_time"), stats.d_cpu_time);
+  histogram_from_json(j.at("max_rss"), stats.d_max_rss);
+}
 
-  if (t1.size() > t2.size())
+/**
+ * Read the seeds of test runs from given file, one hexadecimal seed per line.
+ * Empty lines and lines starting with '#' are ignored.
+ */
+std::vector<uint64_t>
+read_seeds(const std::string& file_name)
+{
+  std::vector<uint64_t> res;
+  std::ifstream in = open_input_file(file_name, false);
+  std::string line;
+  while (std::getline(in, line))
   {
-    std::swap(t1, t2);
+    std::stringstream ss(rstrip(line));
+    ss >> std::ws;
+    if (ss.eof() || ss.peek() == '#') continue;
+    uint64_t seed;
+    ss >> std::hex >> seed;
+    MURXLA_EXIT_ERROR(ss.fail() || !ss.eof())
+        << "invalid seed '" << line << "' in seeds file '" << file_name << "'";
+    res.push_back(seed);
   }
+  MURXLA_EXIT_ERROR(res.empty())
+      << "no seeds in seeds file '" << file_name << "'";
+  return res;
+}
 
-  diff = t2.size() - t1.size();
-  for (size_t i = 0; i < t1.size(); ++i)
+/**
+ * The fraction of the memory limit the peak resident set size of a crashed
+ * test run process must reach for the crash to be classified as memout.
+ */
+const double MEMOUT_RSS_RATIO = 0.9;
+
+/**
+ * Map the exit status of a terminated test run process to a result.
+ *
+ * Only allocations via operator new that exceed the memory limit terminate
+ * the process with EXIT_MEMOUT (see set_memory_limit()). Allocations via
+ * malloc (e.g., in solvers implemented in C) that exceed the limit usually
+ * end in an abort or segfault instead. Failed processes are thus classified
+ * as memout if their peak resident set size is close to the memory limit.
+ *
+ * status      : The exit status of the process.
+ * rusage      : The resource usage of the process.
+ * memory_limit: The memory limit of the process in MB, 0 for no limit.
+ * start_rss   : The resident set size of the process in KiB when the test run
+ *               was started, only its growth counts towards the limit.
+ */
+Result
+get_result_from_status(int32_t status,
+                       const struct rusage& rusage,
+                       uint64_t memory_limit,
+                       uint64_t start_rss = 0)
+{
+  Result res = RESULT_ERROR;
+  if (WIFEXITED(status))
   {
-    if (t1[i] != t2[i])
+    switch (WEXITSTATUS(status))
     {
-      /* Ignore numbers for diff. */
-      for (size_t j = 0; j < t1[i].size(); ++j)
-      {
-        if (std::isdigit(t1[i][j])) continue;
-        ++diff;
-      }
+      case EXIT_OK: return RESULT_OK;
+      case EXIT_ERROR_CONFIG: return RESULT_ERROR_CONFIG;
+      case EXIT_ERROR_UNTRACE: return RESULT_ERROR_UNTRACE;
+      case EXIT_MEMOUT: return RESULT_MEMOUT;
+      default: assert(WEXITSTATUS(status) == EXIT_ERROR);
     }
   }
-  return diff;
+  else
+  {
+    assert(WIFSIGNALED(status));
+  }
+  uint64_t max_rss = static_cast<uint64_t>(rusage.ru_maxrss);
+  if (memory_limit && max_rss > start_rss
+      && static_cast<double>(max_rss - start_rss)
+             >= MEMOUT_RSS_RATIO * static_cast<double>(memory_limit * 1024))
+  {
+    res = RESULT_MEMOUT;
+  }
+  return res;
+}
+
+/**
+ * Handler for allocations that fail in test run processes with a memory
+ * limit. Terminates the process without running any cleanup since this may
+ * again require memory.
+ */
+void
+handle_memout()
+{
+  const char msg[] = "[murxla] memory limit exceeded\n";
+  ssize_t res      = write(STDERR_FILENO, msg, sizeof(msg) - 1);
+  (void) res;
+  _exit(EXIT_MEMOUT);
+}
+
+/**
+ * Get the size of the address space of the current process in bytes and its
+ * resident set size in KiB.
+ */
+std::pair<uint64_t, uint64_t>
+get_self_memory()
+{
+  uint64_t size = 0, resident = 0;
+  std::ifstream statm("/proc/self/statm");
+  statm >> size >> resident;
+  uint64_t page_size = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+  return std::make_pair(size * page_size, resident * page_size / 1024);
+}
+
+/**
+ * Reset the peak resident set size of the current process to its current
+ * resident set size. Returns false if this is not supported (Linux < 4.0).
+ */
+bool
+reset_peak_rss()
+{
+  std::ofstream clear_refs("/proc/self/clear_refs");
+  clear_refs << "5";
+  clear_refs.close();
+  return !clear_refs.fail();
+}
+
+/**
+ * Limit the address space of the current (test run) process to `limit` MB
+ * in addition to `base`, its size in bytes when the test run was started.
+ * Allocations that exceed the limit terminate the process with exit code
+ * EXIT_MEMOUT.
+ *
+ * Only the soft limit is set, a persistent process thus sets the limit anew
+ * for each of its test runs.
+ */
+void
+set_memory_limit(uint64_t limit, uint64_t base)
+{
+  struct rlimit rlim;
+  MURXLA_EXIT_ERROR(getrlimit(RLIMIT_AS, &rlim) != 0)
+      << "failed to get memory limit";
+  rlim.rlim_cur = base + limit * 1024 * 1024;
+  if (rlim.rlim_max != RLIM_INFINITY)
+  {
+    rlim.rlim_cur = std::min(rlim.rlim_cur, rlim.rlim_max);
+  }
+  MURXLA_EXIT_ERROR(setrlimit(RLIMIT_AS, &rlim) != 0)
+      << "failed to set memory limit";
+  std::set_new_handler(handle_memout);
+}
+
+/**
+ * Get the CPU time of the current process and its collected child processes
+ * (e.g., an online solver) in seconds, and their peak resident set size in
+ * KiB.
+ */
+std::pair<double, uint64_t>
+get_self_usage()
+{
+  struct rusage self, children;
+  getrusage(RUSAGE_SELF, &self);
+  getrusage(RUSAGE_CHILDREN, &children);
+  return std::make_pair(
+      Supervisor::get_cpu_time(self) + Supervisor::get_cpu_time(children),
+      static_cast<uint64_t>(std::max(self.ru_maxrss, children.ru_maxrss)));
+}
+
+/**
+ * Copy file, create parent directories of the destination if necessary.
+ */
+void
+copy_file(const std::string& from, const std::string& to)
+{
+  std::filesystem::path fp(to);
+  if (fp.has_parent_path() && !std::filesystem::exists(fp.parent_path()))
+  {
+    std::filesystem::create_directories(fp.parent_path());
+  }
+  std::filesystem::copy(
+      from, to, std::filesystem::copy_options::overwrite_existing);
 }
 
-double
-error_diff(const std::string& e1, const std::string& e2)
+/**
+ * Write given contents to a file, creating its parent directories if
+ * necessary.
+ */
+void
+write_file(const std::string& file_name, const std::string& contents)
 {
-  size_t len  = std::max(e1.size(), e2.size());
-  size_t diff = str_diff(e1, e2);
-  return static_cast<double>(diff) / static_cast<double>(len);
+  std::filesystem::path fp(file_name);
+  if (fp.has_parent_path() && !std::filesystem::exists(fp.parent_path()))
+  {
+    std::filesystem::create_directories(fp.parent_path());
+  }
+  std::ofstream out = open_output_file(file_name, false);
+  out << contents;
 }
 
 }  // namespace
@@ -142,6 +531,7 @@ error_diff(const std::string& e1, const std::string& e2)
 /* -------------------------------------------------------------------------- */
 
 Murxla::Murxla(statistics::Statistics* stats,
+               uint32_t num_stats,
                const Options& options,
                SolverOptions* solver_options,
                ErrorMap* error_map,
@@ -149,10 +539,14 @@ Murxla::Murxla(statistics::Statistics* stats,
     : d_options(options),
       d_solver_options(solver_options),
       d_tmp_dir(tmp_dir),
+      d_stats_shards(stats),
+      d_num_stats_shards(num_stats),
       d_stats(stats),
+      d_dummy_stats(std::make_unique<statistics::Statistics>()),
       d_errors(error_map)
 {
   assert(stats);
+  assert(num_stats > std::max(d_options.jobs, 1u));
   assert(solver_options);
   load_solver_profile();
 
@@ -175,9 +569,6 @@ Murxla::run(uint64_t seed,
             bool record_stats,
             Murxla::TraceMode trace_mode)
 {
-  std::string tmp_file_out = get_tmp_file_path("run-tmp1.out", d_tmp_dir);
-  std::string tmp_file_err = get_tmp_file_path("run-tmp1.err", d_tmp_dir);
-
   /* If we don't run forked, and an explicit api trace file name is given, the
    * trace is immediately written to the given file (rather than writing it
    * first to a temp file).  This is because else, we don't get a chance to
@@ -195,8 +586,6 @@ Murxla::run(uint64_t seed,
 
   Result res = run_aux(seed,
                        time,
-                       tmp_file_out,
-                       tmp_file_err,
                        tmp_api_trace_file_name,
                        untrace_file_name,
                        run_forked,
@@ -224,16 +613,7 @@ Murxla::run(uint64_t seed,
     if (copy_from != copy_to)
     {
       assert(std::filesystem::exists(copy_from));
-
-      // Create parent directories if they do not exist yet.
-      std::filesystem::path fp(copy_to);
-      if (fp.has_parent_path() && !std::filesystem::exists(fp.parent_path()))
-      {
-        std::filesystem::create_directories(fp.parent_path());
-      }
-      std::filesystem::copy(copy_from,
-                            copy_to,
-                            std::filesystem::copy_options::overwrite_existing);
+      copy_file(copy_from, copy_to);
     }
   }
   // Print terminating "}" for main() function of native API traces.
@@ -242,21 +622,10 @@ Murxla::run(uint64_t seed,
     std::cout << "}" << std::endl;
   }
 
+  /* The output of the test run is only written to disk if requested. */
   if (run_forked)
   {
-    std::ofstream err = open_output_file(file_err, true);
-    std::ofstream out = open_output_file(file_out, true);
-
-    std::ifstream tmp_out = open_input_file(tmp_file_out, true);
-    out << tmp_out.rdbuf();
-    tmp_out.close();
-
-    std::ifstream tmp_err = open_input_file(tmp_file_err, true);
-    err << tmp_err.rdbuf();
-    tmp_err.close();
-
-    out.close();
-    err.close();
+    d_capture->write(file_out, file_err);
   }
   return res;
 }
@@ -264,238 +633,749 @@ Murxla::run(uint64_t seed,
 void
 Murxla::test()
 {
-  uint64_t num_timeouts = 0, num_printed_lines = 0;
-  uint64_t error_id = 0, error_nduplicates = 0;
-  uint32_t num_runs         = 0;
-  double start_time         = get_cur_wall_time();
-  std::string out_file_name = DEVNULL;
+  TestStatus status;
+  status.start_time         = get_cur_wall_time();
+  uint32_t num_started_runs = 0;
+  double checkpoint_time    = status.start_time;
   SeedGenerator sg;
   if (d_options.is_seeded)
   {
     sg.set_seed(d_options.seed);
   }
 
-  std::string err_file_name = get_tmp_file_path("tmp.err", d_tmp_dir);
-  Terminal term;
+  /* The time limit learned from the run times of previous test runs. */
+  AdaptiveTimeLimit time_limit;
+
+  /* Seeds of test runs that were started but not executed to the end, e.g.,
+   * since the persistent worker process terminated early or since the
+   * campaign was interrupted. They are executed before new test runs. */
+  std::deque<uint64_t> pending_seeds;
 
-  do
+  /* Continue an interrupted campaign. */
+  if (d_options.resume)
   {
-    double cur_time = get_cur_wall_time();
+    read_checkpoint(sg,
+                    status.num_runs,
+                    num_started_runs,
+                    pending_seeds,
+                    status.num_timeouts,
+                    status.num_adaptive_timeouts,
+                    status.num_memouts,
+                    time_limit);
+  }
+  status.num_resumed_runs = status.num_runs;
 
-    uint64_t seed = sg.next();
+  /* The seeds of all test runs if given, else seeds are generated. */
+  std::vector<uint64_t> fixed_seeds;
+  if (!d_options.seeds_file_name.empty())
+  {
+    fixed_seeds = read_seeds(d_options.seeds_file_name);
+  }
 
-    if (num_printed_lines % 100 == 0)
+  /* In coverage-guided mode, test runs that covered new solver edges are
+   * kept in a corpus, and test runs are biased towards their configuration
+   * (the enabled theories). */
+  SeedCorpus corpus;
+  RNGenerator coverage_rng(sg.get_seed());
+
+  /* The statistics stream, a record is written every stats_interval seconds
+   * and at the end. */
+  std::unique_ptr<StatsStream> stats_stream;
+  double stats_time   = status.start_time;
+  uint32_t stats_runs = status.num_runs;
+  std::vector<uint64_t> stats_actions(MURXLA_MAX_N_ACTIONS);
+  if (!d_options.stats_stream.empty())
+  {
+    stats_stream = std::make_unique<StatsStream>(d_options.stats_stream);
+    auto stats   = std::make_unique<statistics::Statistics>();
+    get_stats(*stats);
+    stats_actions.assign(stats->d_actions,
+                         stats->d_actions + MURXLA_MAX_N_ACTIONS);
+  }
+  auto write_stats_record = [&](double cur_time) {
+    double interval       = cur_time - stats_time;
+    nlohmann::json record = {
+        {"time", cur_time},
+        {"pid", getpid()},
+        {"seed", sg.get_seed()},
+        {"elapsed", cur_time - status.start_time},
+        {"runs", status.num_runs},
+        {"runs_per_sec",
+         interval > 0 ? (status.num_runs - stats_runs) / interval : 0},
+        {"timeouts", status.num_timeouts},
+        {"adaptive_timeouts", status.num_adaptive_timeouts},
+        {"memouts", status.num_memouts},
+        {"dropped_records", stats_stream->get_num_dropped()}};
+    if (d_coverage)
     {
-      std::cout << std::setw(16) << "seed";
-      std::cout << " " << std::setw(5) << "runs";
-      std::cout << " " << std::setw(8) << "r/s";
-      std::cout << " " << std::setw(5) << "sat";
-      std::cout << " " << std::setw(5) << "unsat";
-      std::cout << " " << std::setw(5) << "unknw";
-      std::cout << " " << std::setw(5) << "to";
-      std::cout << " " << std::setw(5) << "err";
+      record["edges"]  = d_coverage->get_num_edges();
+      record["corpus"] = corpus.size();
+    }
+    auto stats = std::make_unique<statistics::Statistics>();
+    get_stats(*stats);
+    add_stats_to_record(
+        record, *stats, *d_errors, status.num_runs, stats_actions, interval);
+    stats_stream->write(record.dump());
+    stats_time = cur_time;
+    stats_runs = status.num_runs;
+  };
 
-      std::cout << std::endl;
-      ++num_printed_lines;
-    }
-
-    std::cout << std::setw(16) << std::hex << seed << std::dec;
-    std::cout << " " << std::setw(5) << num_runs;
-    std::cout << " " << std::setw(8) << std::setprecision(2) << std::fixed;
-    std::cout << num_runs / (cur_time - start_time);
-    std::cout << " " << std::setw(5) << d_stats->d_results[Solver::Result::SAT];
-    std::cout << " " << std::setw(5)
-              << d_stats->d_results[Solver::Result::UNSAT];
-    std::cout << " " << std::setw(5)
-              << d_stats->d_results[Solver::Result::UNKNOWN];
-    std::cout << " " << std::setw(5) << num_timeouts;
-    std::cout << " " << std::setw(5) << d_errors->size();
-    std::cout << std::flush;
-    num_runs++;
-
-    /* Note: If the selected solver is SOLVER_SMT2 and no online solver is
-     *       configured, we'll never run into the error case below and replay
-     *       (the Smt2Solver only answers 'unknown' and dumps SMT2 -> should
-     *       never terminate with an error).  We therefore dump every generated
-     *       sequence to smt2 continuously. */
-
-    /* Run and test for error without tracing to trace file (we by default still
-     * trace to stdout here, which is redirected to /dev/null).
-     * If error encountered, replay and trace below. */
+  Terminal term;
+
+  /* Note: If the selected solver is SOLVER_SMT2 and no online solver is
+   *       configured, we'll never run into the error case below and replay
+   *       (the Smt2Solver only answers 'unknown' and dumps SMT2 -> should
+   *       never terminate with an error).  We therefore dump every generated
+   *       sequence to smt2 continuously. */
+  bool smt2_offline =
+      (d_options.solver == SOLVER_SMT2 && d_options.solver_binary.empty());
+
+  /* Each worker writes its temp files into a separate directory. */
+  std::vector<Worker> workers(std::max(d_options.jobs, 1u));
+  for (size_t i = 0, n = workers.size(); i < n; ++i)
+  {
+    Worker& worker = workers[i];
+    worker.tmp_dir =
+        get_tmp_file_path("worker-" + std::to_string(i), d_tmp_dir);
+    std::filesystem::create_directories(worker.tmp_dir);
+    worker.id      = i;
+    worker.capture = std::make_unique<OutputCapture>(worker.tmp_dir);
+    worker.stats   = &d_stats_shards[i + 1];
+    /* The trace of the test run is only needed to save it on error. */
+    if (!smt2_offline)
+    {
+      worker.trace_buffer = std::make_unique<TraceBuffer>();
+    }
+  }
 
-    std::string api_trace_file_name = get_api_trace_file_name(seed);
-    bool smt2_offline =
-        (d_options.solver == SOLVER_SMT2 && d_options.solver_binary.empty());
-    Result res =
-        run(seed,
-            d_options.time,
-            out_file_name,
-            err_file_name,
-            api_trace_file_name,
-            d_options.untrace_file_name,
-            true,
-            true,
-            // for the SMT2 offline mode we want to store all SMT2 files
-            smt2_offline ? TO_FILE : NONE);
-
-    std::string errmsg, errmsg_filtered;
-    ErrorKind errkind = ErrorKind::ERROR;
-    /* report status */
-    if (res == RESULT_OK)
-    {
-      if (term.is_term())
+  /* In persistent mode, each worker process executes multiple test runs and
+   * reports on them via a mailbox in shared memory, followed by the result
+   * slots of the test runs of all mailboxes. */
+  uint32_t persistent_runs = std::max(d_options.persistent_runs, 1u);
+  Mailbox* mailboxes       = nullptr;
+  size_t mailboxes_size =
+      (sizeof(Mailbox) + sizeof(Mailbox::RunResult) * persistent_runs)
+      * workers.size();
+  if (persistent_runs > 1)
+  {
+    void* m = mmap(nullptr,
+                   mailboxes_size,
+                   PROT_WRITE | PROT_READ,
+                   MAP_SHARED | MAP_ANONYMOUS,
+                   -1,
+                   0);
+    MURXLA_EXIT_ERROR(m == MAP_FAILED) << "failed to allocate mailboxes";
+    mailboxes = static_cast<Mailbox*>(m);
+    auto results =
+        reinterpret_cast<Mailbox::RunResult*>(mailboxes + workers.size());
+    for (size_t i = 0, n = workers.size(); i < n; ++i)
+    {
+      workers[i].mailbox = new (&mailboxes[i]) Mailbox();
+      workers[i].mailbox->d_results = &results[i * persistent_runs];
+      for (size_t j = 0; j < persistent_runs; ++j)
       {
-        term.erase(std::cout);
+        new (&results[i * persistent_runs + j]) Mailbox::RunResult();
       }
-      else
+    }
+  }
+
+  /* In coverage-guided mode, solver edges are recorded per test run. */
+  if (d_options.coverage_guided)
+  {
+    d_coverage = std::make_unique<CoverageMap>(workers.size(), persistent_runs);
+  }
+
+  /* In mutation mode, test runs untrace mutations of the traces of the given
+   * corpus. Only traces recorded with the current configuration are used. */
+  if (!d_options.mutation_corpus.empty())
+  {
+    d_mutator = std::make_unique<TraceMutator>(d_options.cmd_line_trace);
+    MURXLA_CHECK_CONFIG(d_mutator->add(d_options.mutation_corpus) > 0)
+        << "no API traces recorded with the current configuration found in '"
+        << d_options.mutation_corpus << "'";
+  }
+
+  /* The seeds of the test runs that were started but did not finish yet
+   * are saved with the checkpoint to be executed again on resume, since
+   * test runs finish out of order. */
+  auto save_checkpoint = [&]() {
+    std::vector<uint64_t> unfinished_seeds(pending_seeds.begin(),
+                                           pending_seeds.end());
+    for (const auto& worker : workers)
+    {
+      if (worker.pid && !worker.is_replay)
       {
-        std::cout << std::endl;
-        ++num_printed_lines;
+        unfinished_seeds.insert(unfinished_seeds.end(),
+                                worker.seeds.begin() + worker.num_reported,
+                                worker.seeds.end());
       }
     }
-    else
+    write_checkpoint(sg,
+                     status.num_runs,
+                     num_started_runs,
+                     unfinished_seeds,
+                     status.num_timeouts,
+                     status.num_adaptive_timeouts,
+                     status.num_memouts,
+                     time_limit);
+  };
+
+  for (;;)
+  {
+    /* Do not start new test runs when testing was interrupted. */
+    if (s_interrupted)
+    {
+      break;
+    }
+
+    /* Start new test runs on idle workers.
+     *
+     * Run and test for error without tracing to trace file (we by default
+     * still trace to stdout here, which is redirected to /dev/null).
+     * If error encountered, replay and trace below. */
+    for (auto& worker : workers)
     {
-      /* Read error file and check if we already encounterd the same error. */
-      if (res == RESULT_ERROR || res == RESULT_ERROR_CONFIG
-          || res == RESULT_ERROR_UNTRACE)
+      if (worker.pid) continue;
+
+      std::vector<uint64_t> seeds;
+      while (seeds.size() < persistent_runs)
       {
-        std::ifstream errs = open_input_file(err_file_name, false);
-        std::string line;
-        while (std::getline(errs, line))
-        {
-          errmsg += line + "\n";
-        }
-        if (res == RESULT_ERROR)
+        if (!pending_seeds.empty())
         {
-          std::tie(errkind, errmsg_filtered, error_id, error_nduplicates) =
-              add_error(errmsg, seed);
+          seeds.push_back(pending_seeds.front());
+          pending_seeds.pop_front();
         }
-        else if (res == RESULT_ERROR_CONFIG)
+        else if ((d_options.max_runs == 0
+                  || num_started_runs < d_options.max_runs)
+                 && (fixed_seeds.empty()
+                     || num_started_runs < fixed_seeds.size()))
         {
-          term.erase(std::cout);
-          MURXLA_CHECK_CONFIG(false) << errmsg_filtered << " " << d_error_msg;
+          uint64_t seed = fixed_seeds.empty() ? sg.next()
+                                              : fixed_seeds[num_started_runs];
+          if (!corpus.empty()
+              && coverage_rng.pick_with_prob(COVERAGE_GUIDED_PROB))
+          {
+            d_seed_theories[seed] =
+                mask_to_theories(corpus.pick(coverage_rng).d_theories);
+          }
+          seeds.push_back(seed);
+          ++num_started_runs;
         }
         else
         {
-          assert(res == RESULT_ERROR_UNTRACE);
-          MURXLA_CHECK_TRACE(false) << errmsg_filtered << " " << d_error_msg;
+          break;
         }
       }
-
-      std::stringstream info;
-      info << " [";
-      switch (res)
+      if (!seeds.empty())
       {
-        case RESULT_ERROR:
-          if (errkind == ErrorKind::DUPLICATE)
-          {
-            info << term.green() << "duplicate:" << error_id;
-          }
-          else if (errkind == ErrorKind::ERROR)
-          {
-            info << term.red() << "error:" << error_id;
-          }
-          else if (errkind == ErrorKind::FILTER)
-          {
-            info << term.gray() << "filtered";
-          }
-          break;
-        case RESULT_ERROR_CONFIG: info << term.red() << "config error"; break;
-        case RESULT_ERROR_UNTRACE: info << term.red() << "untrace error"; break;
-        case RESULT_TIMEOUT:
-          info << term.blue() << "timeout";
-          ++num_timeouts;
-          break;
-        default: assert(res == RESULT_UNKNOWN); info << "unknown";
+        double time = d_options.adaptive_time
+                          ? time_limit.get(d_options.time)
+                          : d_options.time;
+        // for the SMT2 offline mode we want to store all SMT2 files
+        start_worker(worker, seeds, time, smt2_offline ? TO_FILE : NONE);
       }
-      info << term.defaultcolor() << "]";
+    }
 
-      std::cout << info.str() << std::flush;
-      if (res == RESULT_ERROR && errkind != ErrorKind::FILTER)
-      {
-        std::cout << " ";
-      }
-      else
+    if (std::none_of(workers.begin(), workers.end(), [](const Worker& w) {
+          return w.pid != 0;
+        }))
+    {
+      break;
+    }
+
+    auto event = wait_workers(workers, pending_seeds);
+    if (!event)
+    {
+      continue;
+    }
+    auto [widx, res] = *event;
+    Worker& worker   = workers[widx];
+    uint64_t seed    = worker.seed;
+    double cur_time  = get_cur_wall_time();
+
+    /* The processes of the workers receive the interrupt, too. Test runs
+     * that terminate after the interrupt are thus not reported but executed
+     * again on resume. */
+    if (s_interrupted)
+    {
+      if (!worker.is_replay && !worker.exit_failure)
       {
-        std::cout << std::endl;
-        ++num_printed_lines;
+        pending_seeds.push_front(seed);
       }
+      break;
+    }
+
+    /* Replays of failed test runs are reported when they are done. */
+    if (worker.is_replay)
+    {
+      report_replay(status, term, worker, res);
+      continue;
+    }
 
-      /* Replay and trace on error.
-       *
-       * If SMT2 solver with online solver configured, dump smt2 on replay.
-       * If SMT2 solver configured without an online solver, we'll never enter
-       * here (the SMT2 solver should never return an error result). */
-      if (res != RESULT_TIMEOUT && errkind != ErrorKind::FILTER)
+    /* Failures of a persistent process after its last reported test run are
+     * not attributed to any seed to not count the last seed twice. */
+    if (worker.exit_failure)
+    {
+      term.erase(std::cout);
+      std::cout << std::setw(16) << "exit";
+      std::cout << " [" << term.red() << "exit " << res << term.defaultcolor()
+                << "]" << std::endl;
+      std::string errmsg = worker.capture->err();
+      if (!rstrip(errmsg).empty())
       {
-        // No need to replay SMT2 since we already have the SMT2 problem.
-        if (smt2_offline)
-        {
-          std::cout << get_smt2_file_name(seed, api_trace_file_name)
-                    << std::endl;
-        }
-        else
-        {
-          assert(error_id > 0);
-          api_trace_file_name = get_api_trace_file_name(seed, error_id);
-          Result res_replay = replay(seed,
-                                     out_file_name,
-                                     err_file_name,
-                                     api_trace_file_name,
-                                     d_options.untrace_file_name);
-
-          std::cout << api_trace_file_name << std::endl;
-
-          // Note: This may happen in few cases where the replay runs into a
-          // timeout, but the original run does not.
-          MURXLA_WARN(res != res_replay)
-              << "Replay did not return the same result as original run. "
-              << "Original run returned " << res << ", but replay returned "
-              << res_replay << ".";
-        }
+        std::cout << errmsg << "\n" << std::endl;
       }
-      /* Print new error message after it was found. */
-      if (res == RESULT_ERROR && errkind == ErrorKind::ERROR)
+      status.num_printed_lines = 0;  // print header again after error
+      continue;
+    }
+
+    /* Test runs that timed out are recorded with the time limit as run
+     * time. */
+    if (d_options.adaptive_time)
+    {
+      time_limit.add(res == RESULT_TIMEOUT ? worker.time_limit
+                                           : worker.run_time);
+    }
+    d_stats->d_cpu_time.add(static_cast<uint64_t>(worker.cpu_time * 1000000));
+    d_stats->d_max_rss.add(worker.max_rss);
+
+    if (d_coverage)
+    {
+      const auto& info =
+          d_coverage->get_run_info(widx, worker.num_reported - 1);
+      if (info.d_new_edges > 0)
       {
-        std::cout << std::endl;
-        std::cout << rstrip(errmsg_filtered) << "\n" << std::endl;
-        num_printed_lines = 0;  // print header again after error
-
-        // If it is the first error, we also store the error message in a text
-        // file.
-        assert(error_nduplicates == 1);
-        std::filesystem::path fp(api_trace_file_name);
-        std::string text_file = prepend_path(fp.parent_path(), "error.txt");
-        std::ofstream os(text_file);
-        os << errmsg_filtered << "\n";
+        corpus.add(seed, info.d_theories, info.d_new_edges);
       }
     }
-  } while (d_options.max_runs == 0 || num_runs < d_options.max_runs);
-}
 
-Result
-Murxla::replay(uint64_t seed,
-               const std::string& out_file_name,
-               const std::string& err_file_name,
-               const std::string& api_trace_file_name,
-               const std::string& untrace_file_name)
-{
-  Result res = run(seed,
-                   0,
-                   out_file_name,
-                   err_file_name,
-                   api_trace_file_name,
-                   untrace_file_name,
-                   true,
-                   false,
-                   TO_FILE);
+    report_result(status, term, workers, worker, res, smt2_offline, cur_time);
 
-  if (d_options.dd)
+    d_seed_theories.erase(seed);
+
+    if (!d_options.checkpoint_file_name.empty()
+        && cur_time - checkpoint_time >= d_options.checkpoint_interval)
+    {
+      save_checkpoint();
+      checkpoint_time = cur_time;
+    }
+    if (stats_stream && cur_time - stats_time >= d_options.stats_interval)
+    {
+      write_stats_record(cur_time);
+    }
+  }
+  term.erase(std::cout);
+
+  if (stats_stream)
   {
-    DD(this, seed).run(api_trace_file_name, d_options.dd_trace_file_name);
+    write_stats_record(get_cur_wall_time());
   }
-  return res;
-}
+
+  if (!d_options.checkpoint_file_name.empty())
+  {
+    save_checkpoint();
+  }
+  kill_workers(workers);
+
+  if (mailboxes)
+  {
+    MURXLA_EXIT_ERROR(munmap(mailboxes, mailboxes_size))
+        << "failed to deallocate mailboxes";
+  }
+
+  if (d_coverage)
+  {
+    MURXLA_WARN(d_coverage->get_num_edges() == 0)
+        << "no solver coverage recorded, coverage-guided testing requires a "
+           "solver instrumented with -fsanitize-coverage=trace-pc-guard or "
+           "-fsanitize-coverage=trace-pc";
+    d_coverage.reset();
+  }
+  d_mutator.reset();
+}
+
+void
+Murxla::print_status(TestStatus& status,
+                     const Terminal& term,
+                     uint64_t seed,
+                     double cur_time)
+{
+  /* Erase status line of the previous run if it terminated successfully. */
+  term.erase(std::cout);
+
+  if (status.num_printed_lines % 100 == 0)
+  {
+    std::cout << std::setw(16) << "seed";
+    std::cout << " " << std::setw(5) << "runs";
+    std::cout << " " << std::setw(8) << "r/s";
+    std::cout << " " << std::setw(5) << "sat";
+    std::cout << " " << std::setw(5) << "unsat";
+    std::cout << " " << std::setw(5) << "unknw";
+    std::cout << " " << std::setw(5) << "to";
+    if (d_options.adaptive_time)
+    {
+      std::cout << " " << std::setw(5) << "ato";
+    }
+    if (d_options.memory_limit)
+    {
+      std::cout << " " << std::setw(5) << "mo";
+    }
+    if (d_coverage)
+    {
+      std::cout << " " << std::setw(8) << "cov";
+    }
+    std::cout << " " << std::setw(5) << "err";
+
+    std::cout << std::endl;
+    ++status.num_printed_lines;
+  }
+
+  std::cout << std::setw(16) << std::hex << seed << std::dec;
+  std::cout << " " << std::setw(5) << status.num_runs;
+  std::cout << " " << std::setw(8) << std::setprecision(2) << std::fixed;
+  std::cout << (status.num_runs - status.num_resumed_runs)
+                   / (cur_time - status.start_time);
+  std::cout << " " << std::setw(5) << get_num_results(Solver::Result::SAT);
+  std::cout << " " << std::setw(5) << get_num_results(Solver::Result::UNSAT);
+  std::cout << " " << std::setw(5) << get_num_results(Solver::Result::UNKNOWN);
+  std::cout << " " << std::setw(5) << status.num_timeouts;
+  if (d_options.adaptive_time)
+  {
+    std::cout << " " << std::setw(5) << status.num_adaptive_timeouts;
+  }
+  if (d_options.memory_limit)
+  {
+    std::cout << " " << std::setw(5) << status.num_memouts;
+  }
+  if (d_coverage)
+  {
+    std::cout << " " << std::setw(8) << d_coverage->get_num_edges();
+  }
+  std::cout << " " << std::setw(5) << d_errors->size();
+  std::cout << std::flush;
+}
+
+void
+Murxla::report_result(TestStatus& status,
+                      const Terminal& term,
+                      std::vector<Worker>& workers,
+                      Worker& worker,
+                      Result res,
+                      bool smt2_offline,
+                      double cur_time)
+{
+  uint64_t seed = worker.seed;
+
+  /* SMT2 files of successful test runs are copied by the worker process. */
+  std::string tmp_smt2_file_name = get_tmp_file_path(SMT2_FILE, worker.tmp_dir);
+  if (smt2_offline && res != RESULT_OK
+      && std::filesystem::exists(tmp_smt2_file_name))
+  {
+    copy_file(tmp_smt2_file_name,
+              get_smt2_file_name(seed, d_options.untrace_file_name));
+  }
+
+  print_status(status, term, seed, cur_time);
+  status.num_runs++;
+
+  if (res == RESULT_OK)
+  {
+    if (!term.is_term())
+    {
+      std::cout << std::endl;
+      ++status.num_printed_lines;
+    }
+    return;
+  }
+
+  std::string errmsg, errmsg_filtered;
+  ErrorKind errkind   = ErrorKind::ERROR;
+  uint64_t error_id = 0, error_nduplicates = 0;
+
+  /* Read error file and check if we already encounterd the same error. */
+  if (res == RESULT_ERROR || res == RESULT_ERROR_CONFIG
+      || res == RESULT_ERROR_UNTRACE)
+  {
+    errmsg = worker.capture->err();
+    if (!errmsg.empty() && errmsg.back() != '\n')
+    {
+      errmsg += "\n";
+    }
+    if (res == RESULT_ERROR)
+    {
+      std::tie(errkind, errmsg_filtered, error_id, error_nduplicates) =
+          add_error(errmsg, seed);
+    }
+    else
+    {
+      d_error_msg = errmsg;
+      kill_workers(workers);
+      if (res == RESULT_ERROR_CONFIG)
+      {
+        term.erase(std::cout);
+        MURXLA_CHECK_CONFIG(false) << errmsg_filtered << " " << d_error_msg;
+      }
+      else
+      {
+        assert(res == RESULT_ERROR_UNTRACE);
+        MURXLA_CHECK_TRACE(false) << errmsg_filtered << " " << d_error_msg;
+      }
+    }
+  }
+
+  std::stringstream info;
+  info << " [";
+  switch (res)
+  {
+    case RESULT_ERROR:
+      if (errkind == ErrorKind::DUPLICATE)
+      {
+        info << term.green() << "duplicate:" << error_id;
+      }
+      else if (errkind == ErrorKind::ERROR)
+      {
+        info << term.red() << "error:" << error_id;
+      }
+      else if (errkind == ErrorKind::FILTER)
+      {
+        info << term.gray() << "filtered";
+      }
+      break;
+    case RESULT_ERROR_CONFIG: info << term.red() << "config error"; break;
+    case RESULT_ERROR_UNTRACE: info << term.red() << "untrace error"; break;
+    case RESULT_TIMEOUT:
+      /* A timeout is adaptive if the test run was killed before reaching the
+       * maximum time limit. */
+      if (worker.time_limit != d_options.time)
+      {
+        info << term.blue() << "adaptive timeout";
+        ++status.num_adaptive_timeouts;
+      }
+      else
+      {
+        info << term.blue() << "timeout";
+        ++status.num_timeouts;
+      }
+      break;
+    case RESULT_MEMOUT:
+      info << term.blue() << "memout";
+      ++status.num_memouts;
+      break;
+    default: assert(res == RESULT_UNKNOWN); info << "unknown";
+  }
+  info << term.defaultcolor() << "]";
+  /* Test runs with overridden options are reproduced with these. */
+  std::string seed_options = get_seed_options(seed);
+  if (!seed_options.empty())
+  {
+    info << " (" << seed_options << ")";
+  }
+
+  std::cout << info.str() << std::flush;
+  if (res == RESULT_ERROR && errkind != ErrorKind::FILTER)
+  {
+    std::cout << " ";
+  }
+  else
+  {
+    std::cout << std::endl;
+    ++status.num_printed_lines;
+  }
+
+  std::string api_trace_file_name = get_api_trace_file_name(seed);
+  if (res != RESULT_TIMEOUT && res != RESULT_MEMOUT
+      && errkind != ErrorKind::FILTER)
+  {
+    api_trace_file_name = save_failed_run(worker, res, error_id, smt2_offline);
+  }
+
+  /* Print new error message after it was found. */
+  if (res == RESULT_ERROR && errkind == ErrorKind::ERROR)
+  {
+    std::cout << std::endl;
+    std::cout << rstrip(errmsg_filtered) << "\n" << std::endl;
+    status.num_printed_lines = 0;  // print header again after error
+
+    // If it is the first error, we also store the error message in a text
+    // file.
+    assert(error_nduplicates == 1);
+    std::filesystem::path fp(api_trace_file_name);
+    std::string text_file = prepend_path(fp.parent_path(), "error.txt");
+    std::ofstream os(text_file);
+    os << errmsg_filtered << "\n";
+  }
+}
+
+std::string
+Murxla::save_failed_run(Worker& worker,
+                        Result res,
+                        uint64_t error_id,
+                        bool smt2_offline)
+{
+  uint64_t seed                   = worker.seed;
+  std::string api_trace_file_name = get_api_trace_file_name(seed);
+
+  /* If SMT2 solver with online solver configured, dump smt2 on replay.
+   * If SMT2 solver configured without an online solver, we only get here for
+   * unknown results (the SMT2 solver should never return an error result). */
+  if (smt2_offline)
+  {
+    // No need to replay SMT2 since we already have the SMT2 problem.
+    std::cout << get_smt2_file_name(seed, api_trace_file_name) << std::endl;
+    return api_trace_file_name;
+  }
+
+  assert(error_id > 0);
+  api_trace_file_name = get_api_trace_file_name(seed, error_id);
+  /* Save the trace of the failed test run from shared memory if complete,
+   * else replay the test run to get the trace. */
+  if (worker.trace_buffer && !worker.trace_buffer->is_truncated())
+  {
+    /* For the SMT2 solver, we only write the SMT2 file. */
+    if (!d_options.dd && d_options.solver == SOLVER_SMT2)
+    {
+      write_file(get_smt2_file_name(seed, d_options.untrace_file_name),
+                 worker.trace_buffer->str());
+    }
+    else
+    {
+      write_file(api_trace_file_name, worker.trace_buffer->str());
+    }
+    if (d_options.dd)
+    {
+      start_replay(worker, res, api_trace_file_name, false);
+    }
+  }
+  else
+  {
+    start_replay(worker, res, api_trace_file_name, true);
+  }
+  std::cout << api_trace_file_name << std::endl;
+  return api_trace_file_name;
+}
+
+void
+Murxla::start_replay(Worker& worker,
+                     Result res,
+                     const std::string& api_trace_file_name,
+                     bool replay_run)
+{
+  assert(worker.pid == 0);
+
+  /* Make sure that pending output is not duplicated into the child. */
+  std::cout << std::flush;
+
+  worker.seeds.clear();
+  worker.num_reported = 0;
+  worker.terminated   = false;
+  worker.timed_out    = false;
+  worker.exit_failure = false;
+  worker.is_replay    = true;
+  worker.start_time   = get_cur_wall_time();
+  worker.time_limit   = 0;
+  worker.capture->clear();
+  if (worker.mailbox)
+  {
+    worker.mailbox->d_num_started   = 0;
+    worker.mailbox->d_num_completed = 0;
+  }
+  worker.pid = fork();
+
+  MURXLA_CHECK(worker.pid >= 0) << "forking replay process failed.";
+
+  if (worker.pid)
+  {
+    /* The test runs of the replay are subject to the time limit, delta
+     * debugging may take arbitrarily long. */
+    d_supervisor.add(worker.pid, 0);
+    return;
+  }
+
+  /* child */
+  signal(SIGINT, SIG_DFL);  // reset stats signal handler
+  worker.capture->redirect();
+  /* The test runs of the replay are children of this process, and use the
+   * temp directory of the worker to not interfere with other replays. */
+  d_supervisor.reset();
+  d_tmp_dir = worker.tmp_dir;
+  d_capture.reset();
+  try
+  {
+    if (replay_run)
+    {
+      Result res_replay = replay(worker.seed,
+                                 DEVNULL,
+                                 DEVNULL,
+                                 api_trace_file_name,
+                                 d_options.untrace_file_name);
+      // Note: This may happen in few cases where the replay runs into
+      // a timeout, but the original run does not.
+      MURXLA_WARN(res != res_replay)
+          << "Replay did not return the same result as original run. "
+          << "Original run returned " << res << ", but replay returned "
+          << res_replay << ".";
+    }
+    else
+    {
+      DD(this, worker.seed)
+          .run(api_trace_file_name, d_options.dd_trace_file_name);
+    }
+  }
+  catch (MurxlaException& e)
+  {
+    MURXLA_EXIT_ERROR_FORK(true, true) << e.get_msg();
+  }
+  exit(EXIT_OK);
+}
+
+void
+Murxla::report_replay(TestStatus& status,
+                      const Terminal& term,
+                      Worker& worker,
+                      Result res)
+{
+  std::string output = worker.capture->out() + worker.capture->err();
+  if (res == RESULT_OK && rstrip(output).empty()) return;
+
+  term.erase(std::cout);
+  std::cout << std::setw(16) << std::hex << worker.seed << std::dec;
+  std::cout << " [" << (res == RESULT_OK ? term.gray() : term.red())
+            << "replay";
+  if (res != RESULT_OK)
+  {
+    std::cout << " " << res;
+  }
+  std::cout << term.defaultcolor() << "]" << std::endl;
+  if (!output.empty())
+  {
+    std::cout << output << "\n" << std::endl;
+  }
+  status.num_printed_lines = 0;  // print header again after output
+}
+
+Result
+Murxla::replay(uint64_t seed,
+               const std::string& out_file_name,
+               const std::string& err_file_name,
+               const std::string& api_trace_file_name,
+               const std::string& untrace_file_name)
+{
+  Result res = run(seed,
+                   0,
+                   out_file_name,
+                   err_file_name,
+                   api_trace_file_name,
+                   untrace_file_name,
+                   true,
+                   false,
+                   TO_FILE);
+
+  if (d_options.dd)
+  {
+    DD(this, seed).run(api_trace_file_name, d_options.dd_trace_file_name);
+  }
+  return res;
+}
 
 Solver*
 Murxla::new_solver(SolverSeedGenerator& sng,
@@ -561,12 +1441,9 @@ Murxla::create_fsm(RNGenerator& rng,
                    std::ostream& trace,
                    std::ostream& smt2_out,
                    bool record_stats,
-                   bool in_untrace_replay_mode) const
+                   bool in_untrace_replay_mode,
+                   const TheoryVector* theories) const
 {
-  /* Dummy statistics object for the cases were we don't want to record
-   * statistics (replay, dd). */
-  statistics::Statistics dummy_stats;
-
   if (!d_options.cmd_line_trace.empty())
   {
     trace << d_options.cmd_line_trace << std::endl;
@@ -583,11 +1460,12 @@ Murxla::create_fsm(RNGenerator& rng,
              d_options.smtlib_compliant,
              d_options.fuzz_options,
              d_options.fuzz_options_filter,
-             record_stats ? d_stats : &dummy_stats,
-             d_options.enabled_theories,
+             record_stats ? d_stats : d_dummy_stats.get(),
+             theories ? *theories : d_options.enabled_theories,
              d_options.disabled_theories,
              d_options.solver_options,
-             in_untrace_replay_mode);
+             in_untrace_replay_mode,
+             d_options.adaptive_weights);
 }
 
 void
@@ -606,8 +1484,6 @@ Murxla::print_fsm() const
 Result
 Murxla::run_aux(uint64_t seed,
                 double time,
-                const std::string& file_out,
-                const std::string& file_err,
                 std::string& api_trace_file_name,
                 const std::string& untrace_file_name,
                 bool run_forked,
@@ -615,9 +1491,8 @@ Murxla::run_aux(uint64_t seed,
                 Murxla::TraceMode trace_mode,
                 std::string& error_msg)
 {
-  int32_t status, fd;
   Result result;
-  pid_t pid_solver = 0, pid_timeout = 0;
+  pid_t pid_solver = 0;
   std::ofstream file_trace, file_smt2;
   std::ostream smt2_out(std::cout.rdbuf());
   std::ostream trace(std::cout.rdbuf());
@@ -662,20 +1537,16 @@ Murxla::run_aux(uint64_t seed,
     }
   }
 
-  /* The global random number generator. Used everywhere, except for in the
-   * solvers, which maintain their own RNG, seed with seeds from the solver
-   * seed generator. This guarantees that runs can be reproduced even when
-   * solvers use the RNG in their API wrapper functions. */
-  RNGenerator rng(seed);
-  /* The solver seed generator.  Responsible for generating seeds to be used to
-   * seed the random generator of the solver. */
-  SolverSeedGenerator sng(seed);
-
   result = RESULT_UNKNOWN;
 
   /* If seeded, run in main process. */
   if (run_forked)
   {
+    if (!d_capture)
+    {
+      d_capture = std::make_unique<OutputCapture>(d_tmp_dir);
+    }
+    d_capture->clear();
     pid_solver = fork();
 
     MURXLA_CHECK(pid_solver >= 0) << "forking solver process failed.";
@@ -684,74 +1555,29 @@ Murxla::run_aux(uint64_t seed,
   /* parent */
   if (pid_solver)
   {
-    /* If a time limit is given, fork another process that kills the pid_solver
-     * after time seconds. (https://stackoverflow.com/a/8020324) */
-    if (time != 0)
+    /* Wait for the solver process to terminate or exceed the time limit.
+     * Events of other child processes (test runs of parallel workers in
+     * continuous mode) are kept by the supervisor to be reported later. */
+    d_supervisor.add(pid_solver, time);
+    std::optional<Supervisor::Event> event;
+    do
     {
-      pid_timeout = fork();
-
-      MURXLA_CHECK(pid_timeout >= 0) << "forking timeout process failed";
+      event = d_supervisor.wait(-1, pid_solver);
+    } while (!event);
 
-      if (pid_timeout == 0)
-      {
-        signal(SIGINT, SIG_DFL);  // reset stats signal handler
-        usleep(static_cast<useconds_t>(time * 1000000));
-        exit(EXIT_OK);
-      }
-    }
-
-    /* Wait for the first process to finish (pid_solver or pid_timeout). */
-    pid_t exited_pid = wait(&status);
-
-    if (exited_pid == pid_solver)
+    if (event->d_kind == Supervisor::EventKind::EXIT)
     {
-      /* Kill and collect timeout process if solver process terminated first. */
-      if (pid_timeout)
-      {
-        kill(pid_timeout, SIGKILL);
-        waitpid(pid_timeout, nullptr, 0);
-      }
-      if (WIFEXITED(status))
-      {
-        switch (WEXITSTATUS(status))
-        {
-          case EXIT_OK: result = RESULT_OK; break;
-          case EXIT_ERROR_CONFIG: result = RESULT_ERROR_CONFIG; break;
-          case EXIT_ERROR_UNTRACE: result = RESULT_ERROR_UNTRACE; break;
-          default:
-            assert(WEXITSTATUS(status) == EXIT_ERROR);
-            result = RESULT_ERROR;
-        }
-      }
-      else if (WIFSIGNALED(status))
-      {
-        result = RESULT_ERROR;
-      }
+      result = get_result_from_status(
+          event->d_status, event->d_rusage, d_options.memory_limit);
       if (result == RESULT_ERROR_CONFIG || result == RESULT_ERROR_UNTRACE)
       {
-        std::ifstream ferr(file_err);
-        std::stringstream ss;
-        ss << ferr.rdbuf();
-        error_msg = ss.str();
+        error_msg = d_capture->err();
       }
     }
     else
     {
       /* Kill and collect solver process if time limit is exceeded. */
-      assert(pid_timeout);
-#ifdef MURXLA_COVERAGE
-      /* Try to trigger the abort handler to dump coverage information. */
-      kill(pid_solver, SIGABRT);
-      usleep(100);
-#endif
-      /* Signal the SMT2 solver to kill the online solver process. */
-      if (d_options.solver == SOLVER_SMT2 && !d_options.solver_binary.empty())
-      {
-        kill(pid_solver, SIGINT);
-        usleep(100);
-      }
-      kill(pid_solver, SIGKILL);
-      waitpid(pid_solver, nullptr, 0);
+      kill_run(pid_solver);
       result = RESULT_TIMEOUT;
     }
   }
@@ -766,86 +1592,468 @@ Murxla::run_aux(uint64_t seed,
     if (run_forked)
     {
       /* Redirect stdout and stderr of child process into given files. */
-      fd = open(
-          file_out.c_str(), O_CREAT | O_WRONLY | O_TRUNC, S_IRUSR | S_IWUSR);
-
-      MURXLA_EXIT_ERROR_FORK(fd < 0, true)
-          << "unable to open file " << file_out;
-      dup2(fd, STDOUT_FILENO);
-      close(fd);
-      fd = open(
-          file_err.c_str(), O_CREAT | O_WRONLY | O_TRUNC, S_IRUSR | S_IWUSR);
-      if (fd < 0)
+      d_capture->redirect();
+      if (d_options.memory_limit)
       {
-        perror(0);
-        MURXLA_EXIT_ERROR_FORK(true, true)
-            << "unable to open file " << file_err;
+        /* The address space inherited from the main process (e.g., the trace
+         * buffers of all workers) does not count towards the limit. */
+        set_memory_limit(d_options.memory_limit, get_self_memory().first);
       }
-      dup2(fd, STDERR_FILENO);
-      close(fd);
     }
 
-    try
+    run_fsm(seed, trace, smt2_out, untrace_file_name, run_forked, record_stats);
+
+    if (file_trace.is_open()) file_trace.close();
+
+    if (run_forked)
     {
-      FSM fsm = create_fsm(
-          rng, sng, trace, smt2_out, record_stats, !untrace_file_name.empty());
+      exit(EXIT_OK);
+    }
+    else
+    {
+      result = RESULT_OK;
+    }
+  }
 
-      fsm.configure();
+  return result;
+}
 
-      /* replay/untrace given API trace */
-      if (!untrace_file_name.empty())
+void
+Murxla::run_fsm(uint64_t seed,
+                std::ostream& trace,
+                std::ostream& smt2_out,
+                const std::string& untrace_file_name,
+                bool run_forked,
+                bool record_stats)
+{
+  /* The global random number generator. Used everywhere, except for in the
+   * solvers, which maintain their own RNG, seed with seeds from the solver
+   * seed generator. This guarantees that runs can be reproduced even when
+   * solvers use the RNG in their API wrapper functions. */
+  RNGenerator rng(seed);
+  /* The solver seed generator.  Responsible for generating seeds to be used to
+   * seed the random generator of the solver. */
+  SolverSeedGenerator sng(seed);
+
+  try
+  {
+    /* Test runs scheduled based on coverage use the theories of the
+     * corresponding corpus entry. */
+    const TheoryVector* theories = nullptr;
+    auto it                      = d_seed_theories.find(seed);
+    if (untrace_file_name.empty() && it != d_seed_theories.end())
+    {
+      theories = &it->second;
+    }
+    FSM fsm = create_fsm(rng,
+                         sng,
+                         trace,
+                         smt2_out,
+                         record_stats,
+                         !untrace_file_name.empty(),
+                         theories);
+    if (d_coverage_info)
+    {
+      d_coverage_info->d_theories =
+          theories_to_mask(fsm.get_smgr().get_enabled_theories());
+    }
+
+    fsm.configure();
+
+    /* replay/untrace given API trace */
+    if (!untrace_file_name.empty())
+    {
+      fsm.untrace(untrace_file_name);
+    }
+    /* untrace a mutation of a trace of the corpus */
+    else if (d_mutator)
+    {
+      std::stringstream mutated;
+      d_mutator->mutate(
+          rng, fsm.get_smgr().get_solver(), *d_solver_options, mutated);
+      try
       {
-        fsm.untrace(untrace_file_name);
+        fsm.untrace(mutated, "mutation");
       }
-      /* regular MBT run */
-      else
+      catch (MurxlaUntraceException& e)
       {
-        fsm.run();
+        /* Mutations that can not be replayed are discarded. */
       }
     }
-    catch (MurxlaConfigException& e)
+    /* regular MBT run */
+    else
     {
-      MURXLA_EXIT_ERROR_CONFIG_FORK(true, run_forked) << e.get_msg();
+      fsm.run();
     }
-    catch (MurxlaUntraceException& e)
+  }
+  catch (MurxlaConfigException& e)
+  {
+    MURXLA_EXIT_ERROR_CONFIG_FORK(true, run_forked) << e.get_msg();
+  }
+  catch (MurxlaUntraceException& e)
+  {
+    MURXLA_EXIT_ERROR_UNTRACE_FORK(true, run_forked) << e.get_msg();
+  }
+  catch (MurxlaException& e)
+  {
+    MURXLA_EXIT_ERROR_FORK(true, run_forked) << e.get_msg();
+  }
+}
+
+void
+Murxla::start_worker(Worker& worker,
+                     const std::vector<uint64_t>& seeds,
+                     double time,
+                     TraceMode trace_mode)
+{
+  assert(worker.pid == 0);
+  assert(!seeds.empty());
+  assert(trace_mode == NONE || trace_mode == TO_FILE);
+  assert(!worker.mailbox || seeds.size() <= d_options.persistent_runs);
+
+  /* Make sure that pending output is not duplicated into the child. */
+  std::cout << std::flush;
+
+  worker.seeds        = seeds;
+  worker.num_reported = 0;
+  worker.terminated   = false;
+  worker.timed_out    = false;
+  worker.exit_failure = false;
+  worker.is_replay    = false;
+  worker.start_time   = get_cur_wall_time();
+  worker.time_limit   = time;
+  worker.capture->clear();
+  if (worker.trace_buffer)
+  {
+    worker.trace_buffer->clear();
+  }
+  if (d_coverage)
+  {
+    d_coverage->reset(worker.id);
+  }
+  if (worker.mailbox)
+  {
+    worker.mailbox->d_num_started   = 0;
+    worker.mailbox->d_num_completed = 0;
+    worker.mailbox->d_start_time     = worker.start_time;
+    worker.mailbox->d_start_cpu_time = 0;
+    worker.mailbox->d_start_as_size  = 0;
+    worker.mailbox->d_start_rss      = 0;
+    worker.mailbox->d_peak_rss_reset = false;
+  }
+  worker.pid = fork();
+
+  MURXLA_CHECK(worker.pid >= 0) << "forking solver process failed.";
+
+  if (worker.pid)
+  {
+    d_supervisor.add(worker.pid, time);
+    return;
+  }
+
+  /* child */
+  signal(SIGINT, SIG_DFL);  // reset stats signal handler
+#ifdef MURXLA_COVERAGE
+  signal(SIGABRT, handle_abort);
+#endif
+
+  /* Record into the statistics shard of the worker. */
+  d_stats = worker.stats;
+  worker.capture->redirect();
+  /* In persistent mode, the memory limit is set per test run. */
+  if (d_options.memory_limit && !worker.mailbox)
+  {
+    /* The address space inherited from the main process (e.g., the trace
+     * buffers of all workers) does not count towards the limit. */
+    set_memory_limit(d_options.memory_limit, get_self_memory().first);
+  }
+
+  std::string tmp_api_trace_file_name =
+      get_tmp_file_path(API_TRACE, worker.tmp_dir);
+  std::string tmp_smt2_file_name = get_tmp_file_path(SMT2_FILE, worker.tmp_dir);
+
+  for (size_t i = 0, n = seeds.size(); i < n; ++i)
+  {
+    uint64_t seed = seeds[i];
+    std::ofstream file_trace, file_smt2;
+    std::ostream smt2_out(std::cout.rdbuf());
+    std::ostream trace(std::cout.rdbuf());
+
+    if (worker.mailbox)
     {
-      MURXLA_EXIT_ERROR_UNTRACE_FORK(true, run_forked) << e.get_msg();
+      /* Only keep the output of the current test run. */
+      if (i > 0)
+      {
+        std::cout << std::flush;
+        std::cerr << std::flush;
+        worker.capture->clear(true);
+      }
+      /* The memory limit applies to the growth of the process during the
+       * current test run, and its peak resident set size is reset to be the
+       * peak of the current test run. */
+      bool peak_rss_reset = reset_peak_rss();
+      auto [as_size, rss] = get_self_memory();
+      if (d_options.memory_limit)
+      {
+        set_memory_limit(d_options.memory_limit, as_size);
+      }
+      worker.mailbox->d_start_as_size  = as_size;
+      worker.mailbox->d_start_rss      = rss;
+      worker.mailbox->d_peak_rss_reset = peak_rss_reset;
+      worker.mailbox->d_start_time     = get_cur_wall_time();
+      worker.mailbox->d_start_cpu_time = get_self_usage().first;
+      worker.mailbox->d_num_started    = static_cast<uint32_t>(i + 1);
     }
-    catch (MurxlaException& e)
+
+    if (trace_mode == NONE)
     {
-      MURXLA_EXIT_ERROR_FORK(true, run_forked) << e.get_msg();
+      file_trace = open_output_file(DEVNULL, true);
+      trace.rdbuf(file_trace.rdbuf());
+      if (d_options.solver == SOLVER_SMT2)
+      {
+        smt2_out.rdbuf(file_trace.rdbuf());
+      }
+      /* Trace into shared memory to be saved by the parent on error. */
+      if (worker.trace_buffer)
+      {
+        worker.trace_buffer->clear();
+        if (!d_options.dd && d_options.solver == SOLVER_SMT2)
+        {
+          smt2_out.rdbuf(worker.trace_buffer.get());
+        }
+        else
+        {
+          trace.rdbuf(worker.trace_buffer.get());
+        }
+      }
+    }
+    else
+    {
+      file_trace = open_output_file(tmp_api_trace_file_name, true);
+      trace.rdbuf(file_trace.rdbuf());
+      if (d_options.solver == SOLVER_SMT2)
+      {
+        file_smt2 = open_output_file(tmp_smt2_file_name, true);
+        smt2_out.rdbuf(file_smt2.rdbuf());
+      }
     }
 
-    if (file_trace.is_open()) file_trace.close();
+    if (d_coverage)
+    {
+      d_coverage_info = &d_coverage->start_run(worker.id, i);
+    }
 
-    if (run_forked)
+    run_fsm(seed, trace, smt2_out, d_options.untrace_file_name, true, true);
+
+    if (d_coverage)
     {
-      exit(EXIT_OK);
+      d_coverage_info->d_new_edges = d_coverage->merge(worker.id);
     }
-    else
+
+    if (file_trace.is_open()) file_trace.close();
+    if (file_smt2.is_open())
     {
-      result = RESULT_OK;
+      file_smt2.close();
+      copy_file(tmp_smt2_file_name,
+                get_smt2_file_name(seed, d_options.untrace_file_name));
+    }
+
+    if (worker.mailbox)
+    {
+      auto [cpu_time, max_rss] = get_self_usage();
+      Mailbox::RunResult& result = worker.mailbox->d_results[i];
+      result.d_run_time = get_cur_wall_time() - worker.mailbox->d_start_time;
+      result.d_cpu_time = cpu_time - worker.mailbox->d_start_cpu_time;
+      result.d_max_rss  = max_rss;
+      worker.mailbox->d_num_completed = static_cast<uint32_t>(i + 1);
     }
   }
+  exit(EXIT_OK);
+}
 
-  return result;
+std::optional<std::pair<size_t, Result>>
+Murxla::wait_workers(std::vector<Worker>& workers,
+                     std::deque<uint64_t>& pending_seeds)
+{
+  bool has_mailboxes = std::any_of(workers.begin(),
+                                   workers.end(),
+                                   [](const Worker& w) { return w.mailbox; });
+  for (;;)
+  {
+    for (size_t i = 0, n = workers.size(); i < n; ++i)
+    {
+      Worker& worker = workers[i];
+      if (worker.pid == 0) continue;
+
+      /* Report test runs that were completed by a persistent process. */
+      if (worker.mailbox
+          && worker.mailbox->d_num_completed > worker.num_reported)
+      {
+        const Mailbox::RunResult& result =
+            worker.mailbox->d_results[worker.num_reported];
+        worker.seed     = worker.seeds[worker.num_reported++];
+        worker.run_time = result.d_run_time;
+        worker.cpu_time = result.d_cpu_time;
+        worker.max_rss  = result.d_max_rss;
+        return std::make_pair(i, RESULT_OK);
+      }
+
+      if (worker.terminated)
+      {
+        if (worker.is_replay)
+        {
+          worker.pid = 0;
+          return std::make_pair(
+              i, get_result_from_status(worker.status, worker.rusage, 0));
+        }
+
+        double start_time =
+            worker.mailbox ? worker.mailbox->d_start_time.load()
+                           : worker.start_time;
+        double start_cpu_time =
+            worker.mailbox ? worker.mailbox->d_start_cpu_time.load() : 0;
+        worker.pid      = 0;
+        worker.run_time = get_cur_wall_time() - start_time;
+        worker.cpu_time =
+            Supervisor::get_cpu_time(worker.rusage) - start_cpu_time;
+        worker.max_rss = static_cast<uint64_t>(worker.rusage.ru_maxrss);
+
+        size_t num_started = worker.mailbox
+                                 ? worker.mailbox->d_num_started.load()
+                                 : worker.seeds.size();
+        assert(num_started >= worker.num_reported);
+        /* Seeds of test runs that were not started by the process are
+         * executed by another process. */
+        pending_seeds.insert(pending_seeds.end(),
+                             worker.seeds.begin() + num_started,
+                             worker.seeds.end());
+
+        /* In persistent mode, the peak resident set size of the process can
+         * only be attributed to the current test run if it was reset when
+         * the test run was started, else crashes are not classified as
+         * memout based on it. */
+        uint64_t memory_limit = d_options.memory_limit;
+        uint64_t start_rss    = 0;
+        if (worker.mailbox)
+        {
+          if (worker.mailbox->d_peak_rss_reset)
+          {
+            start_rss = worker.mailbox->d_start_rss;
+          }
+          else
+          {
+            memory_limit = 0;
+          }
+        }
+        Result res = worker.timed_out
+                         ? RESULT_TIMEOUT
+                         : get_result_from_status(worker.status,
+                                                  worker.rusage,
+                                                  memory_limit,
+                                                  start_rss);
+        /* Report the test run the process terminated (or was killed) in. */
+        if (num_started > worker.num_reported)
+        {
+          worker.seed = worker.seeds[worker.num_reported++];
+          return std::make_pair(i, res);
+        }
+        /* The process terminated (or was killed) after all its started test
+         * runs were reported. A failure, e.g., on exit, can thus not be
+         * attributed to a test run and is reported separately. */
+        if (res == RESULT_OK || res == RESULT_TIMEOUT)
+        {
+          return std::nullopt;
+        }
+        worker.exit_failure = true;
+        return std::make_pair(i, res);
+      }
+    }
+
+    /* Mailboxes of persistent workers are checked periodically. */
+    /* Waiting is interrupted by signals, the interrupt is handled by the
+     * caller. */
+    auto event = d_supervisor.wait(has_mailboxes ? MAILBOX_POLL_INTERVAL : -1);
+    if (!event)
+    {
+      if (s_interrupted) return std::nullopt;
+      continue;
+    }
+
+    auto it = std::find_if(workers.begin(), workers.end(), [&](Worker& w) {
+      return w.pid == event->d_pid && !w.terminated;
+    });
+    if (it == workers.end()) continue;
+    Worker& worker = *it;
+
+    if (event->d_kind == Supervisor::EventKind::EXIT)
+    {
+      worker.terminated = true;
+      worker.status     = event->d_status;
+      worker.rusage     = event->d_rusage;
+      continue;
+    }
+
+    /* In persistent mode, the time limit applies to the current test run. */
+    if (worker.mailbox)
+    {
+      double remaining = worker.mailbox->d_start_time + worker.time_limit
+                         - get_cur_wall_time();
+      if (remaining > 0)
+      {
+        d_supervisor.set_timeout(worker.pid, remaining);
+        continue;
+      }
+    }
+    worker.rusage     = kill_run(worker.pid);
+    worker.terminated = true;
+    worker.timed_out  = true;
+  }
 }
 
-std::string
-Murxla::filter_error(const std::string& err)
+void
+Murxla::kill_workers(std::vector<Worker>& workers)
 {
-  std::string res;
-  for (const auto& re : d_error_filters)
+  for (auto& worker : workers)
   {
-    std::smatch sm;
-    std::regex_search(err, sm, std::regex(re));
-    if (sm.size() == 1)
+    if (worker.pid)
     {
-      res = sm[0];
-      break;
+      if (!worker.terminated)
+      {
+        kill(worker.pid, SIGKILL);
+        waitpid(worker.pid, nullptr, 0);
+        d_supervisor.remove(worker.pid);
+      }
+      worker.pid = 0;
     }
   }
-  return res.empty() ? err : res;
+}
+
+struct rusage
+Murxla::kill_run(pid_t pid)
+{
+#ifdef MURXLA_COVERAGE
+  /* Try to trigger the abort handler to dump coverage information. */
+  kill(pid, SIGABRT);
+  usleep(100);
+#endif
+  /* Signal the SMT2 solver to kill the online solver process. */
+  if (d_options.solver == SOLVER_SMT2 && !d_options.solver_binary.empty())
+  {
+    kill(pid, SIGINT);
+    usleep(100);
+  }
+  kill(pid, SIGKILL);
+  struct rusage rusage = {};
+  wait4(pid, nullptr, 0, &rusage);
+  d_supervisor.remove(pid);
+  return rusage;
+}
+
+std::string
+Murxla::filter_error(const std::string& err)
+{
+  auto res = d_error_filters.search(err);
+  return !res || res->empty() ? err : *res;
 }
 
 std::tuple<Murxla::ErrorKind, const std::string, uint64_t, uint64_t>
@@ -854,41 +2062,38 @@ Murxla::add_error(const std::string& err, uint64_t seed)
   std::string filtered_err = filter_error(err);
   std::string err_norm = normalize_asan_error(filtered_err);
 
-  /* Filter errors if specified in the solver profile. */
-  for (const auto& e : d_exclude_errors)
+  /* Filter errors if specified in the solver profile. Errors are classified
+   * as the same error if they differ in at most 5% of characters. */
+  if (d_exclude_error_regex.search(filtered_err)
+      || d_exclude_error_index.find(err_norm))
   {
-    std::smatch sm;
-    std::regex_search(filtered_err, sm, std::regex(e));
-    if (!sm.empty())
-    {
-      return std::make_tuple(ErrorKind::FILTER, filtered_err, 0, 0);
-    }
-
-    /* Errors are classified as the same error if they differ in at most 5% of
-     * characters. */
-    if (error_diff(err_norm, e) <= 0.05)
-    {
-      return std::make_tuple(ErrorKind::FILTER, filtered_err, 0, 0);
-    }
+    return std::make_tuple(ErrorKind::FILTER, filtered_err, 0, 0);
   }
 
-  for (auto& p : *d_errors)
+  auto id = d_error_index.find(err_norm);
+  if (id)
   {
-    const auto& e_norm = p.first;
-    auto& e_info       = p.second;
-
-    /* Errors are classified as the same error if they differ in at most 5% of
-     * characters. */
-    if (error_diff(err_norm, e_norm) <= 0.05)
+    auto& e_info = d_errors->at(d_error_index.get(*id));
+    e_info.seeds.push_back(seed);
+    std::string seed_options = get_seed_options(seed);
+    if (!seed_options.empty())
     {
-      e_info.seeds.push_back(seed);
-      return std::make_tuple(
-          ErrorKind::DUPLICATE, filtered_err, e_info.id, e_info.seeds.size());
+      e_info.seed_options.emplace(seed, seed_options);
     }
+    return std::make_tuple(
+        ErrorKind::DUPLICATE, filtered_err, e_info.id, e_info.seeds.size());
   }
 
-  d_errors->emplace(err_norm,
-                    ErrorInfo(d_errors->size() + 1, filtered_err, {seed}));
+  d_error_index.add(err_norm);
+  auto it = d_errors
+                ->emplace(err_norm,
+                          ErrorInfo(d_errors->size() + 1, filtered_err, {seed}))
+                .first;
+  std::string seed_options = get_seed_options(seed);
+  if (!seed_options.empty())
+  {
+    it->second.seed_options.emplace(seed, seed_options);
+  }
 
   // Export errors to JSON file.
   if (!d_options.export_errors_filename.empty())
@@ -903,6 +2108,170 @@ Murxla::add_error(const std::string& err, uint64_t seed)
   return std::make_tuple(ErrorKind::ERROR, filtered_err, d_errors->size(), 1);
 }
 
+std::string
+Murxla::get_seed_options(uint64_t seed) const
+{
+  auto it = d_seed_theories.find(seed);
+  if (it == d_seed_theories.end())
+  {
+    return "";
+  }
+  return theories_to_options(it->second);
+}
+
+void
+Murxla::write_checkpoint(const SeedGenerator& sg,
+                         uint32_t num_runs,
+                         uint32_t num_started_runs,
+                         const std::vector<uint64_t>& unfinished_seeds,
+                         uint64_t num_timeouts,
+                         uint64_t num_adaptive_timeouts,
+                         uint64_t num_memouts,
+                         const AdaptiveTimeLimit& time_limit) const
+{
+  nlohmann::json j;
+  j["version"]           = CHECKPOINT_VERSION;
+  j["seed"]              = sg.get_seed();
+  j["runs"]              = num_runs;
+  j["started_runs"]      = num_started_runs;
+  j["unfinished_seeds"]  = unfinished_seeds;
+  j["timeouts"]          = num_timeouts;
+  j["adaptive_timeouts"] = num_adaptive_timeouts;
+  j["memouts"]           = num_memouts;
+  j["run_times"]         = histogram_to_json(time_limit.get_run_times());
+  j["errors"]   = nlohmann::json::array();
+  for (const auto& [e_norm, e_info] : *d_errors)
+  {
+    nlohmann::json seed_options = nlohmann::json::object();
+    for (const auto& [seed, options] : e_info.seed_options)
+    {
+      seed_options[std::to_string(seed)] = options;
+    }
+    j["errors"].push_back({{"id", e_info.id},
+                           {"norm", e_norm},
+                           {"errmsg", e_info.errmsg},
+                           {"seeds", e_info.seeds},
+                           {"seed_options", seed_options}});
+  }
+  auto stats = std::make_unique<statistics::Statistics>();
+  get_stats(*stats);
+  j["stats"] = statistics_to_json(*stats);
+
+  /* Write to a temp file first and rename it, such that an interruption
+   * never leaves a partially written checkpoint behind. */
+  std::string tmp_file_name = d_options.checkpoint_file_name + ".tmp";
+  {
+    std::ofstream out = open_output_file(tmp_file_name, false);
+    out << j << std::endl;
+    MURXLA_EXIT_ERROR(!out.good())
+        << "unable to write checkpoint file '" << tmp_file_name << "'";
+  }
+  std::filesystem::rename(tmp_file_name, d_options.checkpoint_file_name);
+}
+
+void
+Murxla::interrupt()
+{
+  s_interrupted = 1;
+}
+
+bool
+Murxla::is_interrupted()
+{
+  return s_interrupted;
+}
+
+void
+Murxla::read_checkpoint(SeedGenerator& sg,
+                        uint32_t& num_runs,
+                        uint32_t& num_started_runs,
+                        std::deque<uint64_t>& unfinished_seeds,
+                        uint64_t& num_timeouts,
+                        uint64_t& num_adaptive_timeouts,
+                        uint64_t& num_memouts,
+                        AdaptiveTimeLimit& time_limit)
+{
+  std::ifstream in = open_input_file(d_options.checkpoint_file_name, false);
+  nlohmann::json j;
+  try
+  {
+    in >> j;
+    MURXLA_EXIT_ERROR(j.at("version") != CHECKPOINT_VERSION)
+        << "unsupported checkpoint version " << j.at("version")
+        << ", expected version " << CHECKPOINT_VERSION;
+
+    sg.set_seed(j.at("seed"));
+    num_runs              = j.at("runs");
+    num_started_runs      = j.value("started_runs", num_runs);
+    num_timeouts          = j.at("timeouts");
+    num_memouts           = j.at("memouts");
+    num_adaptive_timeouts = j.value("adaptive_timeouts", 0);
+    if (j.contains("run_times"))
+    {
+      histogram_from_json(j.at("run_times"), time_limit.get_run_times());
+    }
+    if (j.contains("unfinished_seeds"))
+    {
+      for (uint64_t seed : j.at("unfinished_seeds"))
+      {
+        unfinished_seeds.push_back(seed);
+      }
+    }
+
+    /* Restore errors in the order they were found. */
+    std::vector<nlohmann::json> errors(j.at("errors").begin(),
+                                       j.at("errors").end());
+    std::sort(errors.begin(), errors.end(), [](const auto& a, const auto& b) {
+      return a.at("id") < b.at("id");
+    });
+    for (const auto& e : errors)
+    {
+      std::string e_norm = e.at("norm");
+      std::string errmsg = e.at("errmsg");
+      auto it = d_errors
+                    ->emplace(e_norm,
+                              ErrorInfo(e.at("id"), errmsg, e.at("seeds")))
+                    .first;
+      nlohmann::json seed_options =
+          e.value("seed_options", nlohmann::json::object());
+      for (const auto& [seed, options] : seed_options.items())
+      {
+        it->second.seed_options.emplace(std::stoull(seed),
+                                        options.get<std::string>());
+      }
+      d_error_index.add(e_norm);
+      d_export_errors.push_back(errmsg);
+    }
+    statistics_from_json(j.at("stats"), *d_stats);
+  }
+  catch (const nlohmann::json::exception& e)
+  {
+    MURXLA_EXIT_ERROR(true) << "invalid checkpoint file '"
+                            << d_options.checkpoint_file_name
+                            << "': " << e.what();
+  }
+}
+
+void
+Murxla::get_stats(statistics::Statistics& stats) const
+{
+  for (uint32_t i = 0; i < d_num_stats_shards; ++i)
+  {
+    stats.merge(d_stats_shards[i]);
+  }
+}
+
+uint64_t
+Murxla::get_num_results(Solver::Result res) const
+{
+  uint64_t n = 0;
+  for (uint32_t i = 0; i < d_num_stats_shards; ++i)
+  {
+    n += d_stats_shards[i].d_results[res];
+  }
+  return n;
+}
+
 void
 Murxla::load_solver_profile()
 {
@@ -922,11 +2291,22 @@ Murxla::load_solver_profile()
   }
 
   d_solver_profile.reset(new SolverProfile(profile));
+  /* Query the solver profile once here, prior to forking test runs. The
+   * queried data is seed-independent, test runs thus inherit it rather than
+   * having to query it again. */
+  d_solver_profile->populate_cache();
   auto errors = d_solver_profile->get_excluded_errors();
   d_exclude_errors.insert(errors.begin(), errors.end());
-  auto error_filters = d_solver_profile->get_error_filters();
-  d_error_filters.insert(
-      d_error_filters.end(), error_filters.begin(), error_filters.end());
+  /* Compile the patterns of excluded errors and error filters once. */
+  for (const auto& e : d_exclude_errors)
+  {
+    d_exclude_error_regex.add(e);
+    d_exclude_error_index.add(e);
+  }
+  for (const auto& f : d_solver_profile->get_error_filters())
+  {
+    d_error_filters.add(f);
+  }
 }
 
 std::string
@@ -10,23 +10,36 @@
 #ifndef __MURXLA__MURXLA_H
 #define __MURXLA__MURXLA_H
 
+#include <sys/resource.h>
+#include <sys/types.h>
+
+#include <atomic>
 #include <cstdint>
+#include <deque>
+#include <memory>
+#include <optional>
 #include <string>
 
 #include "action.hpp"
+#include "coverage.hpp"
+#include "error_index.hpp"
 #include "options.hpp"
+#include "regex_set.hpp"
 #include "result.hpp"
 #include "solver/solver_profile.hpp"
 #include "solver_option.hpp"
+#include "statistics.hpp"
+#include "supervisor.hpp"
 #include "theory.hpp"
+#include "time_limit.hpp"
+#include "trace_buffer.hpp"
+#include "trace_mutator.hpp"
+#include "util.hpp"
 
 namespace murxla {
 
 /* -------------------------------------------------------------------------- */
 
-namespace statistics {
-struct Statistics;
-};
 class Solver;
 
 /* -------------------------------------------------------------------------- */
@@ -41,6 +54,12 @@ struct ErrorInfo
   uint64_t id;
   std::string errmsg;
   std::vector<uint64_t> seeds;
+  /**
+   * The command line options required in addition to the configured options
+   * to reproduce a test run via its seed, by seed (e.g., the theories of test
+   * runs scheduled in coverage-guided mode).
+   */
+  std::unordered_map<uint64_t, std::string> seed_options;
 };
 
 class Murxla
@@ -58,8 +77,16 @@ class Murxla
   inline static const std::string API_TRACE = "tmp-api.trace";
   inline static const std::string SMT2_FILE = "tmp-smt2.smt2";
 
-  /** Constructor. */
+  /**
+   * Constructor.
+   * stats    : The statistics shards in shared memory. Shard 0 is recorded
+   *            into by the main process and test runs in one-shot mode, shard
+   *            `i` by the test runs of worker `i - 1` in continuous mode.
+   * num_stats: The number of statistics shards, at least the number of jobs
+   *            plus one.
+   */
   Murxla(statistics::Statistics* stats,
+         uint32_t num_stats,
          const Options& options,
          SolverOptions* solver_options,
          ErrorMap* error_map,
@@ -70,8 +97,6 @@ class Murxla
    *
    * seed               : The current seed for the RNG.
    * double             : The time limit for one test run.
-   * file_out           : The file to write stdout output of a test run to.
-   * file_err           : The file to write stderr output of a test run to.
    * api_trace_file_name: When non-empty, trace is immediately written to file
    *                      if 'run_forked' is false. Else, 'api_trace_file_name'
    *                      is set to the name of the temp trace file name and
@@ -96,9 +121,26 @@ class Murxla
              bool record_stats,
              TraceMode trace_mode);
 
-  /** Continuous test run. */
+  /**
+   * Continuous test run.
+   *
+   * Executes up to `d_options.jobs` test runs in parallel, each in a forked
+   * child process. The main process acts as coordinator, i.e., it collects
+   * the results of the test runs and is the only process that modifies the
+   * error map. Failed test runs are replayed (and delta debugged) by a
+   * process on the worker of the test run, other workers continue testing.
+   */
   void test();
 
+  /**
+   * Interrupt the continuous testing campaign.
+   * Only sets a flag and is thus safe to be called from a signal handler,
+   * test() stops at the next opportunity and writes the checkpoint.
+   */
+  static void interrupt();
+  /** Return true if the continuous testing campaign was interrupted. */
+  static bool is_interrupted();
+
   /** Print the current configuration of the FSM to stdout. */
   void print_fsm() const;
 
@@ -134,6 +176,146 @@ class Murxla
     FILTER,    /* Error message filtered out. */
   };
 
+  /**
+   * Shared-memory mailbox of a worker in persistent mode, used by the
+   * process of the worker to report on its test runs.
+   *
+   * A test run that terminates within the process always terminated
+   * successfully (result RESULT_OK), a test run that fails terminates the
+   * process. The number of completed test runs thus determines the results
+   * of all test runs of the process except for the last one, which is
+   * determined from the exit status of the process.
+   */
+  struct Mailbox
+  {
+    /** The result of a completed test run. */
+    struct RunResult
+    {
+      /** The run time of the test run. */
+      std::atomic<double> d_run_time;
+      /** The CPU time of the test run. */
+      std::atomic<double> d_cpu_time;
+      /**
+       * The peak resident set size of the process in KiB during the test
+       * run if `d_peak_rss_reset`, else up to the test run.
+       */
+      std::atomic<uint64_t> d_max_rss;
+    };
+
+    /** The number of test runs started by the worker process so far. */
+    std::atomic<uint32_t> d_num_started;
+    /**
+     * The number of test runs completed by the worker process so far.
+     * Incremented after the result of the test run was written.
+     */
+    std::atomic<uint32_t> d_num_completed;
+    /** The wall clock time when the current test run was started. */
+    std::atomic<double> d_start_time;
+    /** The CPU time of the process when the current test run was started. */
+    std::atomic<double> d_start_cpu_time;
+    /**
+     * The size of the address space of the process in bytes when the current
+     * test run was started. The memory limit applies to the growth beyond it.
+     */
+    std::atomic<uint64_t> d_start_as_size;
+    /**
+     * The resident set size of the process in KiB when the current test run
+     * was started.
+     */
+    std::atomic<uint64_t> d_start_rss;
+    /**
+     * True if the peak resident set size of the process was reset when the
+     * current test run was started, i.e., if it is the peak of the test run.
+     */
+    std::atomic<bool> d_peak_rss_reset;
+    /**
+     * The results of the completed test runs, indexed by the number of the
+     * test run within the process. Results are not overwritten, the parent
+     * may thus fall behind on reporting them.
+     */
+    RunResult* d_results;
+  };
+
+  /** A worker slot that executes test runs in continuous mode. */
+  struct Worker
+  {
+    /** The index of the worker. */
+    size_t id = 0;
+    /** The pid of the process of the worker, 0 if idle. */
+    pid_t pid = 0;
+    /** The seeds of the test runs to be executed by the current process. */
+    std::vector<uint64_t> seeds;
+    /** The number of test runs of the current process reported so far. */
+    size_t num_reported = 0;
+    /** The seed of the test run reported last. */
+    uint64_t seed = 0;
+    /** The wall clock time when the current process was started. */
+    double start_time = 0;
+    /** The time limit per test run of the current process. */
+    double time_limit = 0;
+    /** The run time of the test run reported last. */
+    double run_time = 0;
+    /** The CPU time of the test run reported last. */
+    double cpu_time = 0;
+    /**
+     * The peak resident set size in KiB of the test run reported last. In
+     * persistent mode, this is the peak of the process during this test run,
+     * or up to this test run if the peak could not be reset (Linux < 4.0).
+     */
+    uint64_t max_rss = 0;
+    /** True if the current process terminated. */
+    bool terminated = false;
+    /** True if the current process was killed due to a timeout. */
+    bool timed_out = false;
+    /**
+     * True if the current process failed after all its started test runs
+     * were reported, e.g., on exit (persistent mode).
+     */
+    bool exit_failure = false;
+    /**
+     * True if the current process replays a failed test run (and delta
+     * debugs its trace) instead of executing test runs.
+     */
+    bool is_replay = false;
+    /** The exit status of the current process if it terminated. */
+    int32_t status = 0;
+    /** The resource usage of the current process if it terminated. */
+    struct rusage rusage = {};
+    /** The mailbox of this worker in persistent mode, else nullptr. */
+    Mailbox* mailbox = nullptr;
+    /** The statistics shard the test runs of this worker record into. */
+    statistics::Statistics* stats = nullptr;
+    /** The directory for temp files of this worker. */
+    std::string tmp_dir;
+    /** The capture of the output of the test runs of this worker. */
+    std::unique_ptr<OutputCapture> capture;
+    /**
+     * The buffer for the trace of the current test run in shared memory,
+     * nullptr if the trace is not kept. For the SMT2 solver, this is the
+     * SMT2 output unless delta debugging is enabled.
+     */
+    std::unique_ptr<TraceBuffer> trace_buffer;
+  };
+
+  /** The status of a continuous testing campaign, printed per test run. */
+  struct TestStatus
+  {
+    /** The wall clock time when testing was started. */
+    double start_time = 0;
+    /** The number of test runs so far. */
+    uint32_t num_runs = 0;
+    /** The number of test runs of the resumed campaign, if any. */
+    uint32_t num_resumed_runs = 0;
+    /** The number of test runs that timed out. */
+    uint64_t num_timeouts = 0;
+    /** The number of test runs that timed out at the adaptive time limit. */
+    uint64_t num_adaptive_timeouts = 0;
+    /** The number of test runs that ran out of memory. */
+    uint64_t num_memouts = 0;
+    /** The number of status lines printed since the last header. */
+    uint64_t num_printed_lines = 0;
+  };
+
   /**
    * Create solver.
    *
@@ -156,13 +338,16 @@ class Murxla
    * trace       : The outputstream for the API trace.
    * smt2_out    : The output stream for SMT-LIB output, if enabled.
    * record_stats: True to record statistics.
+   * theories    : The theories to enable instead of the configured ones,
+   *               nullptr to use the configured theories.
    */
   FSM create_fsm(RNGenerator& rng,
                  SolverSeedGenerator& sng,
                  std::ostream& trace,
                  std::ostream& smt2_out,
                  bool record_stats,
-                 bool in_untrace_replay_mode) const;
+                 bool in_untrace_replay_mode,
+                 const TheoryVector* theories = nullptr) const;
 
   /**
    * Auxiliary helper for run().
@@ -170,8 +355,6 @@ class Murxla
    *
    * seed               : The current seed for the RNG.
    * double             : The time limit for one test run.
-   * file_out           : The file to write stdout output of a test run to.
-   * file_err           : The file to write stderr output of a test run to.
    * api_trace_file_name: When non-empty, trace is immediately written to file
    *                      if 'run_forked' is false. Else, 'api_trace_file_name'
    *                      is set to the name of the temp trace file name and
@@ -188,8 +371,6 @@ class Murxla
    */
   Result run_aux(uint64_t seed,
                  double time,
-                 const std::string& file_out,
-                 const std::string& file_err,
                  std::string& api_trace_file_name,
                  const std::string& untrace_file_name,
                  bool run_forked,
@@ -197,6 +378,157 @@ class Murxla
                  TraceMode trace_mode,
                  std::string& error_msg);
 
+  /**
+   * Execute the FSM for a single test run in the current process.
+   *
+   * If run forked, configuration, untrace and other errors terminate the
+   * process with the corresponding exit code.
+   *
+   * seed             : The current seed for the RNG.
+   * trace            : The output stream for the API trace.
+   * smt2_out         : The output stream for SMT-LIB output, if enabled.
+   * untrace_file_name: When non-empty, the name of the trace file to replay.
+   * run_forked       : True if test run is executed in a child process.
+   * record_stats     : True if statistics for this test run should be
+   *                    recorded.
+   */
+  void run_fsm(uint64_t seed,
+               std::ostream& trace,
+               std::ostream& smt2_out,
+               const std::string& untrace_file_name,
+               bool run_forked,
+               bool record_stats);
+
+  /**
+   * Start a process on the given (idle) worker that executes the test runs
+   * for the given seeds.
+   *
+   * The test runs are executed in a forked child process with its stdout and
+   * stderr output redirected to the output capture of the worker. In
+   * persistent mode, the process executes multiple test runs and reports on
+   * them via the mailbox of the worker.
+   *
+   * worker    : The worker to execute the test runs.
+   * seeds     : The seeds for the RNG, one per test run.
+   * time      : The time limit for one test run.
+   * trace_mode: The trace mode for this run, NONE or TO_FILE (SMT2 only).
+   */
+  void start_worker(Worker& worker,
+                    const std::vector<uint64_t>& seeds,
+                    double time,
+                    TraceMode trace_mode);
+
+  /**
+   * Wait until a test run of any of the given busy workers terminates or
+   * exceeds the time limit of the worker. In the latter case, the process of
+   * the test run is killed.
+   *
+   * The seed and run time of the terminated test run are stored in
+   * `Worker::seed` and `Worker::run_time`. Workers whose process terminated
+   * are marked as idle, the seeds of their test runs that were not started
+   * are appended to `pending_seeds`. A process that fails after all its
+   * started test runs were reported is marked via `Worker::exit_failure`.
+   *
+   * workers      : The set of workers.
+   * pending_seeds: The seeds of test runs to be executed by another process.
+   *
+   * Returns the index of the worker whose test run terminated and a result
+   * that indicates the status of the test run, or std::nullopt if the process
+   * of a worker terminated without a test run to report (persistent mode).
+   */
+  std::optional<std::pair<size_t, Result>> wait_workers(
+      std::vector<Worker>& workers, std::deque<uint64_t>& pending_seeds);
+
+  /** Kill all busy workers. */
+  void kill_workers(std::vector<Worker>& workers);
+
+  /**
+   * Print the status line of a reported test run, preceded by the header
+   * every 100 lines.
+   * status  : The status of the campaign.
+   * term    : The terminal to print to.
+   * seed    : The seed of the test run.
+   * cur_time: The current wall clock time.
+   */
+  void print_status(TestStatus& status,
+                    const Terminal& term,
+                    uint64_t seed,
+                    double cur_time);
+
+  /**
+   * Report the result of the test run of given worker reported last: print
+   * its status, register errors and save the trace of failed test runs.
+   * status      : The status of the campaign.
+   * term        : The terminal to print to.
+   * workers     : The set of workers, killed on configuration errors.
+   * worker      : The worker of the test run.
+   * res         : The result of the test run.
+   * smt2_offline: True if the SMT2 solver is used without online solver.
+   * cur_time    : The current wall clock time.
+   */
+  void report_result(TestStatus& status,
+                     const Terminal& term,
+                     std::vector<Worker>& workers,
+                     Worker& worker,
+                     Result res,
+                     bool smt2_offline,
+                     double cur_time);
+
+  /**
+   * Save the trace of the failed test run of given (idle) worker. The trace
+   * is written from the trace buffer of the worker if complete, else the test
+   * run is replayed on the worker (see start_replay()), as well as for delta
+   * debugging.
+   * worker      : The worker of the failed test run.
+   * res         : The result of the failed test run.
+   * error_id    : The id of the error of the test run.
+   * smt2_offline: True if the SMT2 solver is used without online solver.
+   * Returns the name of the API trace file.
+   */
+  std::string save_failed_run(Worker& worker,
+                              Result res,
+                              uint64_t error_id,
+                              bool smt2_offline);
+
+  /**
+   * Start a process on the given (idle) worker that replays its failed test
+   * run, or delta debugs its trace, while other workers continue testing.
+   *
+   * The process supervises its own test runs and writes its output into the
+   * output capture of the worker. Its termination is reported via
+   * wait_workers() with `Worker::is_replay` set.
+   *
+   * worker             : The worker of the failed test run.
+   * res                : The result of the failed test run.
+   * api_trace_file_name: The name of the API trace file of the test run.
+   * replay_run         : True to replay the test run to get its trace, false
+   *                      if the trace was already written.
+   */
+  void start_replay(Worker& worker,
+                    Result res,
+                    const std::string& api_trace_file_name,
+                    bool replay_run);
+
+  /**
+   * Report the termination of a process started via start_replay(): print
+   * its output (e.g., of delta debugging) and whether it failed.
+   * status: The status of the campaign.
+   * term  : The terminal to print to.
+   * worker: The worker of the replay.
+   * res   : The result of the replay process.
+   */
+  void report_replay(TestStatus& status,
+                     const Terminal& term,
+                     Worker& worker,
+                     Result res);
+
+  /**
+   * Kill the process of a test run that exceeded the time limit and collect
+   * it.
+   * Returns the resource usage of the process.
+   */
+  struct rusage kill_run(pid_t pid);
+
   /**
    * Replay a single test run.
    *
@@ -217,10 +549,67 @@ class Murxla
   /** Filter error messages based on filter regex provided in solver profile. */
   std::string filter_error(const std::string& err);
 
+  /**
+   * Get the command line options required in addition to the configured
+   * options to reproduce the test run with the given seed via `-s <seed>`.
+   */
+  std::string get_seed_options(uint64_t seed) const;
+
   /** Register error to d_errors. */
   std::tuple<Murxla::ErrorKind, const std::string, uint64_t, uint64_t>
   add_error(const std::string& err, uint64_t seed);
 
+  /**
+   * Write the state of the current continuous testing campaign to the
+   * checkpoint file: the errors found so far, the statistics, the state
+   * of the seed generator and of the adaptive time limit, and the seeds of
+   * the test runs that were started but did not finish yet.
+   * sg                   : The seed generator of the campaign.
+   * num_runs             : The number of test runs so far.
+   * num_started_runs     : The number of test runs that were started so far.
+   * unfinished_seeds     : The seeds of the started test runs that did not
+   *                        finish yet.
+   * num_timeouts         : The number of test runs that timed out so far.
+   * num_adaptive_timeouts: The number of test runs that timed out at the
+   *                        adaptive time limit so far.
+   * num_memouts          : The number of test runs that ran out of memory
+   *                        so far.
+   * time_limit           : The adaptive time limit of the campaign.
+   */
+  void write_checkpoint(const SeedGenerator& sg,
+                        uint32_t num_runs,
+                        uint32_t num_started_runs,
+                        const std::vector<uint64_t>& unfinished_seeds,
+                        uint64_t num_timeouts,
+                        uint64_t num_adaptive_timeouts,
+                        uint64_t num_memouts,
+                        const AdaptiveTimeLimit& time_limit) const;
+  /**
+   * Restore the state of a continuous testing campaign from the checkpoint
+   * file.
+   * sg                   : The seed generator to restore.
+   * num_runs             : Set to the number of test runs so far.
+   * num_started_runs     : Set to the number of test runs that were started
+   *                        so far.
+   * unfinished_seeds     : The seeds of the started test runs that did not
+   *                        finish are appended to this queue.
+   * num_timeouts         : Set to the number of test runs that timed out so
+   *                        far.
+   * num_adaptive_timeouts: Set to the number of test runs that timed out at
+   *                        the adaptive time limit so far.
+   * num_memouts          : Set to the number of test runs that ran out of
+   *                        memory so far.
+   * time_limit           : The adaptive time limit to restore.
+   */
+  void read_checkpoint(SeedGenerator& sg,
+                       uint32_t& num_runs,
+                       uint32_t& num_started_runs,
+                       std::deque<uint64_t>& unfinished_seeds,
+                       uint64_t& num_timeouts,
+                       uint64_t& num_adaptive_timeouts,
+                       uint64_t& num_memouts,
+                       AdaptiveTimeLimit& time_limit);
+
   /** Load solver profile of currently configured solver. */
   void load_solver_profile();
 
@@ -230,18 +619,65 @@ class Murxla
   std::string get_api_trace_file_name(uint64_t seed,
                                       uint64_t error_id = 0) const;
 
-  /** Statistics of current test run(s). */
+  /**
+   * Aggregate the statistics of all shards.
+   * stats: The statistics to add the statistics of all shards to.
+   */
+  void get_stats(statistics::Statistics& stats) const;
+  /** Get the number of given check-sat results over all statistics shards. */
+  uint64_t get_num_results(Solver::Result res) const;
+
+  /** The statistics shards. */
+  statistics::Statistics* d_stats_shards;
+  /** The number of statistics shards. */
+  uint32_t d_num_stats_shards;
+  /** The statistics shard to record the current test run(s) into. */
   statistics::Statistics* d_stats;
+  /**
+   * Statistics object for the cases where we don't want to record statistics
+   * (replay, dd).
+   */
+  std::unique_ptr<statistics::Statistics> d_dummy_stats;
   /** Map normalized error message to pair (original error message, seeds). */
   ErrorMap* d_errors;
 
+  /** Index of the errors in d_errors to find duplicate errors. */
+  ErrorIndex d_error_index;
+
   std::unordered_set<std::string> d_exclude_errors;
-  std::vector<std::string> d_error_filters;
+  /** The patterns of d_exclude_errors. */
+  RegexSet d_exclude_error_regex;
+  /** Index of d_exclude_errors to find errors to be filtered. */
+  ErrorIndex d_exclude_error_index;
+  /** The error filters of the solver profile. */
+  RegexSet d_error_filters;
 
   std::unique_ptr<SolverProfile> d_solver_profile;
 
   /** Stores error messages to be exported when --export-errors is enabled. */
   std::vector<std::string> d_export_errors;
+
+  /** The supervisor for the child processes of test runs. */
+  Supervisor d_supervisor;
+  /** The solver edge coverage of continuous test runs if coverage-guided. */
+  std::unique_ptr<CoverageMap> d_coverage;
+  /**
+   * The coverage information of the current test run if recorded, filled in
+   * by run_fsm().
+   */
+  CoverageMap::RunInfo* d_coverage_info = nullptr;
+  /**
+   * The theories of test runs that were scheduled with the configuration of a
+   * corpus entry of coverage-guided testing, by seed.
+   */
+  std::unordered_map<uint64_t, TheoryVector> d_seed_theories;
+  /**
+   * The corpus of API traces to mutate in continuous mode, if mutation mode
+   * is enabled via --mutate.
+   */
+  std::unique_ptr<TraceMutator> d_mutator;
+  /** The capture of the output of forked test runs executed via run(). */
+  std::unique_ptr<OutputCapture> d_capture;
 };
 
 /* -------------------------------------------------------------------------- */
@@ -80,8 +80,12 @@ Op::get_arg_sort_kind(size_t i) const
 Op&
 OpKindManager::get_op(const Op::Kind& kind)
 {
-  if (d_op_kinds.find(kind) == d_op_kinds.end()) return d_op_undefined;
-  return d_op_kinds.at(kind);
+  uint32_t id = kind.get_id();
+  if (id >= d_op_kind_ids.size() || d_op_kind_ids[id] == nullptr)
+  {
+    return d_op_undefined;
+  }
+  return *d_op_kind_ids[id];
 }
 
 void
@@ -495,8 +499,16 @@ OpKindManager::add_op_kind(const Op::Kind& kind,
     }
     sort_kinds_args.push_back(sk);
   }
-  d_op_kinds.emplace(
+  auto [it_op, inserted] = d_op_kinds.emplace(
       kind, Op(id, kind, arity, nidxs, sort_kinds, sort_kinds_args, theory));
+  if (inserted)
+  {
+    if (kind.get_id() >= d_op_kind_ids.size())
+    {
+      d_op_kind_ids.resize(kind.get_id() + 1, nullptr);
+    }
+    d_op_kind_ids[kind.get_id()] = &it_op->second;
+  }
   strncpy(d_stats->d_op_kinds[id], kind.c_str(), kind.size());
 }
 
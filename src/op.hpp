@@ -12,9 +12,11 @@
 
 #include <cassert>
 #include <cstdint>
+#include <map>
 #include <unordered_map>
 #include <vector>
 
+#include "interned_string.hpp"
 #include "sort.hpp"
 
 namespace murxla {
@@ -28,8 +30,13 @@ struct Statistics;
 /** The struct representing an operator. */
 struct Op
 {
-  /** The kind of an operator. */
-  using Kind = std::string;
+  /**
+   * The kind of an operator.
+   *
+   * Operator kinds are strings, interned into dense ids (see InternedString)
+   * for cheap comparison, hashing and indexing.
+   */
+  using Kind = InternedString<Op>;
 
   /**
    * \addtogroup operator-kinds
@@ -3318,8 +3325,13 @@ struct Op
 using OpKindVector = std::vector<Op::Kind>;
 /** A std::unordered_set of operator kinds. */
 using OpKindSet    = std::unordered_set<Op::Kind>;
-/** A std::unordered_map mapping operator kind to operator. */
-using OpKindMap    = std::unordered_map<Op::Kind, Op>;
+/**
+ * A std::map mapping operator kind to operator.
+ * Ordered by the name of the kind (not by its interned id), such that the
+ * order of operators, and thus picking an operator, does not depend on the
+ * order in which kinds were interned.
+ */
+using OpKindMap    = std::map<Op::Kind, Op>;
 /**
  * A std::unordered_map mapping sort kind of an operator to operator kinds of
  * that sort kind.
@@ -3413,6 +3425,11 @@ class OpKindManager
 
   /** The set of enabled operator kinds. Maps Op::Kind to Op. */
   OpKindMap d_op_kinds;
+  /**
+   * Maps the id of an operator kind (see Op::Kind) to the corresponding Op in
+   * d_op_kinds, nullptr if the kind is not enabled.
+   */
+  std::vector<Op*> d_op_kind_ids;
   /** The set of enabled theories. */
   TheorySet d_enabled_theories;
   /** Enabled sort kinds. */
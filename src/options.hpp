@@ -33,13 +33,54 @@ struct Options
   uint32_t verbosity = 0;
   /** The time limit for one test run (one API sequence). */
   double time = 1;
+  /**
+   * True to adapt the time limit for one test run to the observed run times
+   * in continuous mode, bounded by `time`.
+   */
+  bool adaptive_time = false;
+  /**
+   * The memory limit for one test run in MB, 0 for no limit. Limits the
+   * address space the test run process may allocate in addition to the
+   * address space it inherits from the main process.
+   */
+  uint64_t memory_limit = 0;
   /** The maximum number of test runs to perform. */
   uint32_t max_runs = 0;
+  /**
+   * The file with the seeds (one hexadecimal seed per line) of the test runs
+   * to perform in continuous mode, instead of randomly generated seeds.
+   */
+  std::string seeds_file_name;
+  /** The number of test runs to execute in parallel in continuous mode. */
+  uint32_t jobs = 1;
+  /**
+   * The number of test runs to execute in one process in continuous mode
+   * (persistent mode if greater than 1).
+   */
+  uint32_t persistent_runs = 1;
+  /**
+   * True to record the edge coverage of the solver under test in continuous
+   * mode and bias test runs towards the configurations of test runs that
+   * covered new edges. Requires a solver instrumented with
+   * -fsanitize-coverage=trace-pc-guard or -fsanitize-coverage=trace-pc.
+   */
+  bool coverage_guided = false;
+  /**
+   * The API trace or directory of API traces to mutate in continuous mode
+   * instead of generating new API traces.
+   */
+  std::string mutation_corpus;
 
   /** True if seed is provided by user. */
   bool is_seeded = false;
   /** True to use simple instead of completely random symbols for inputs. */
   bool simple_symbols = true;
+  /**
+   * True to adapt the weights of actions to their success ratio and to how
+   * often they make progress (create new sorts or new combinations of
+   * operator and sort kind) during a test run.
+   */
+  bool adaptive_weights = false;
   /** True to only generate SMT-LIB compliant API traces. */
   bool smtlib_compliant = false;
   /** True to print statistics. */
@@ -118,6 +159,21 @@ struct Options
   /** Output file for exporting errors in JSON format. */
   std::string export_errors_filename = "";
 
+  /** The file to periodically write the state of continuous testing to. */
+  std::string checkpoint_file_name;
+  /** The interval in seconds for writing the checkpoint file. */
+  double checkpoint_interval = 60;
+  /** True to resume continuous testing from the checkpoint file. */
+  bool resume = false;
+
+  /**
+   * The file or Unix domain socket (`unix:<path>`) to periodically write
+   * statistics records (JSON lines) to in continuous mode.
+   */
+  std::string stats_stream;
+  /** The interval in seconds for writing statistics records. */
+  double stats_interval = 1;
+
   /** Print native solver API trace. */
   bool solver_trace = false;
 };
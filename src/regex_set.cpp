@@ -0,0 +1,231 @@
+/***
+ * Murxla: A Model-Based API Fuzzer for SMT solvers.
+ *
+ * This file is part of Murxla.
+ *
+ * Copyright (C) 2019-2022 by the authors listed in the AUTHORS file.
+ *
+ * See LICENSE for more information on using this software.
+ */
+#include "regex_set.hpp"
+
+#include <cctype>
+#include <deque>
+
+#include "except.hpp"
+
+namespace murxla {
+
+/* -------------------------------------------------------------------------- */
+
+void
+RegexSet::add(const std::string& pattern)
+{
+  size_t id = d_patterns.size();
+  try
+  {
+    d_patterns.push_back({std::regex(pattern), false});
+  }
+  catch (const std::regex_error& e)
+  {
+    MURXLA_EXIT_ERROR_CONFIG(true)
+        << "invalid regular expression `" << pattern << "': " << e.what();
+  }
+
+  std::string literal = get_required_literal(pattern);
+  if (literal.empty())
+  {
+    return;
+  }
+  d_patterns.back().d_has_literal = true;
+
+  size_t node = 0;
+  for (char c : literal)
+  {
+    auto it = d_nodes[node].d_next.find(c);
+    if (it == d_nodes[node].d_next.end())
+    {
+      d_nodes.emplace_back();
+      it = d_nodes[node].d_next.emplace(c, d_nodes.size() - 1).first;
+    }
+    node = it->second;
+  }
+  d_nodes[node].d_patterns.push_back(id);
+  d_built = false;
+}
+
+std::optional<std::string>
+RegexSet::search(const std::string& s) const
+{
+  if (!d_built)
+  {
+    build();
+  }
+
+  /* Determine the patterns whose required literal occurs in the string. */
+  std::vector<bool> candidates(d_patterns.size());
+  size_t node = 0;
+  for (char c : s)
+  {
+    for (;;)
+    {
+      auto it = d_nodes[node].d_next.find(c);
+      if (it != d_nodes[node].d_next.end())
+      {
+        node = it->second;
+        break;
+      }
+      if (node == 0) break;
+      node = d_nodes[node].d_fail;
+    }
+    for (size_t n = node; n != 0; n = d_nodes[n].d_fail)
+    {
+      for (size_t id : d_nodes[n].d_patterns)
+      {
+        candidates[id] = true;
+      }
+    }
+  }
+
+  for (size_t i = 0, n = d_patterns.size(); i < n; ++i)
+  {
+    if (!candidates[i] && d_patterns[i].d_has_literal) continue;
+    std::smatch sm;
+    if (std::regex_search(s, sm, d_patterns[i].d_regex))
+    {
+      return sm[0].str();
+    }
+  }
+  return std::nullopt;
+}
+
+std::string
+RegexSet::get_required_literal(const std::string& pattern)
+{
+  std::string res, cur;
+  size_t depth = 0;
+
+  auto end_run = [&res, &cur]() {
+    if (cur.size() > res.size()) res = cur;
+    cur.clear();
+  };
+
+  for (size_t i = 0, n = pattern.size(); i < n; ++i)
+  {
+    char c = pattern[i];
+    switch (c)
+    {
+      case '\\':
+        if (i + 1 == n) return "";
+        c = pattern[++i];
+        if (std::isalnum(static_cast<unsigned char>(c)))
+        {
+          /* Character classes, control escapes, back references, ... */
+          if (c == 'x') i += 2;
+          else if (c == 'u') i += 4;
+          else if (c == 'c') i += 1;
+          end_run();
+        }
+        else if (depth == 0)
+        {
+          cur.push_back(c);
+        }
+        break;
+
+      case '[':
+        /* Skip bracket expression. */
+        ++i;
+        if (i < n && pattern[i] == '^') ++i;
+        if (i < n && pattern[i] == ']') ++i;
+        while (i < n && pattern[i] != ']')
+        {
+          if (pattern[i] == '\\') ++i;
+          ++i;
+        }
+        end_run();
+        break;
+
+      case '(':
+        ++depth;
+        end_run();
+        break;
+
+      case ')':
+        if (depth > 0) --depth;
+        end_run();
+        break;
+
+      case '|':
+        /* Top-level alternatives have no common required literal. */
+        if (depth == 0) return "";
+        break;
+
+      case '*':
+      case '?':
+      case '{':
+        /* The previous atom is optional. */
+        if (!cur.empty()) cur.pop_back();
+        if (c == '{')
+        {
+          while (i < n && pattern[i] != '}') ++i;
+        }
+        end_run();
+        break;
+
+      case '+':
+      case '.':
+      case '^':
+      case '$': end_run(); break;
+
+      default:
+        if (depth == 0)
+        {
+          cur.push_back(c);
+        }
+    }
+  }
+  end_run();
+  return res;
+}
+
+void
+RegexSet::build() const
+{
+  /* Compute fail links in breadth-first order. */
+  std::deque<size_t> queue;
+  for (const auto& [c, child] : d_nodes[0].d_next)
+  {
+    d_nodes[child].d_fail = 0;
+    queue.push_back(child);
+  }
+  while (!queue.empty())
+  {
+    size_t node = queue.front();
+    queue.pop_front();
+    for (const auto& [c, child] : d_nodes[node].d_next)
+    {
+      size_t fail = d_nodes[node].d_fail;
+      for (;;)
+      {
+        auto it = d_nodes[fail].d_next.find(c);
+        if (it != d_nodes[fail].d_next.end() && it->second != child)
+        {
+          fail = it->second;
+          break;
+        }
+        if (fail == 0)
+        {
+          break;
+        }
+        fail = d_nodes[fail].d_fail;
+      }
+      d_nodes[child].d_fail = fail;
+      queue.push_back(child);
+    }
+  }
+  d_built = true;
+}
+
+/* -------------------------------------------------------------------------- */
+
+}  // namespace murxla
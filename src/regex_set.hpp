@@ -0,0 +1,96 @@
+/***
+ * Murxla: A Model-Based API Fuzzer for SMT solvers.
+ *
+ * This file is part of Murxla.
+ *
+ * Copyright (C) 2019-2022 by the authors listed in the AUTHORS file.
+ *
+ * See LICENSE for more information on using this software.
+ */
+#ifndef __MURXLA__REGEX_SET_H
+#define __MURXLA__REGEX_SET_H
+
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <regex>
+#include <string>
+#include <vector>
+
+namespace murxla {
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * A set of regular expressions (ECMAScript) that are matched against a string
+ * at once.
+ *
+ * Patterns are compiled once when added. For each pattern, the longest literal
+ * that any match must contain is extracted. All literals are combined into a
+ * single Aho-Corasick automaton, which determines in one pass over the string
+ * the patterns that can possibly match. Only these (and patterns without a
+ * required literal) are confirmed by matching the compiled regular expression.
+ */
+class RegexSet
+{
+ public:
+  /**
+   * Add a pattern to the set.
+   * Exits with a configuration error if the pattern is not a valid regular
+   * expression.
+   */
+  void add(const std::string& pattern);
+
+  /**
+   * Search for the first pattern (in the order they were added) that matches
+   * a subsequence of given string.
+   * Returns the matched subsequence, or std::nullopt if no pattern matches.
+   */
+  std::optional<std::string> search(const std::string& s) const;
+
+  /** Return true if the set contains no patterns. */
+  bool empty() const { return d_patterns.empty(); }
+
+ private:
+  /** A pattern of the set. */
+  struct Pattern
+  {
+    /** The compiled regular expression. */
+    std::regex d_regex;
+    /** True if the pattern has a required literal. */
+    bool d_has_literal;
+  };
+
+  /** A node of the Aho-Corasick automaton. */
+  struct Node
+  {
+    /** The transitions to child nodes. */
+    std::map<char, size_t> d_next;
+    /** The node of the longest proper suffix in the automaton. */
+    size_t d_fail = 0;
+    /** The ids of the patterns whose literal ends at this node. */
+    std::vector<size_t> d_patterns;
+  };
+
+  /**
+   * Get the longest literal that any match of given pattern must contain.
+   * Returns an empty string if there is no such literal.
+   */
+  static std::string get_required_literal(const std::string& pattern);
+
+  /** Compute the fail links of the automaton. */
+  void build() const;
+
+  /** The patterns of the set. */
+  std::vector<Pattern> d_patterns;
+  /** The nodes of the automaton, node 0 is the root. */
+  mutable std::vector<Node> d_nodes = {Node()};
+  /** True if the fail links of the automaton are up-to-date. */
+  mutable bool d_built = true;
+};
+
+/* -------------------------------------------------------------------------- */
+
+}  // namespace murxla
+
+#endif
@@ -23,6 +23,7 @@ operator<<(std::ostream& out, const Result& res)
     case Result::RESULT_ERROR_CONFIG: out << "config error"; break;
     case Result::RESULT_ERROR_UNTRACE: out << "untrace error"; break;
     case Result::RESULT_TIMEOUT: out << "timeout"; break;
+    case Result::RESULT_MEMOUT: out << "memout"; break;
     default: assert(res == Result::RESULT_UNKNOWN); out << "unknown";
   }
   return out;
@@ -21,6 +21,7 @@ enum Result
   RESULT_ERROR,
   RESULT_ERROR_CONFIG,
   RESULT_ERROR_UNTRACE,
+  RESULT_MEMOUT,
   RESULT_OK,
   RESULT_TIMEOUT,
   RESULT_UNKNOWN,
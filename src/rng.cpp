@@ -35,6 +35,12 @@ SeedGenerator::set_seed(uint64_t s)
   d_seed = s;
 }
 
+uint64_t
+SeedGenerator::get_seed() const
+{
+  return d_seed;
+}
+
 uint64_t
 SeedGenerator::next()
 {
@@ -30,6 +30,8 @@ class SeedGenerator
 
   /** Set seed. */
   void set_seed(uint64_t s);
+  /** Get the current seed, i.e., the seed returned by the next call to next(). */
+  uint64_t get_seed() const;
 
   /** Generate and return the next seed. */
   uint64_t next();
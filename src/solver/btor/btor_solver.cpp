@@ -1613,7 +1613,8 @@ class BtorActionArrayAssignment : public Action
     Btor* btor               = btor_solver.get_solver();
     char **indices = nullptr, **values = nullptr;
     uint32_t size = 0;
-    boolector_array_assignment(btor, btor_term, &indices, &values, &size);
+    MURXLA_API_CALL(
+        boolector_array_assignment(btor, btor_term, &indices, &values, &size));
     if (d_smgr.d_incremental)
     {
       /* assume assignment and check if result is still SAT */
@@ -1635,7 +1636,7 @@ class BtorActionArrayAssignment : public Action
         boolector_release(btor, btor_eq);
         boolector_release(btor, btor_select);
       }
-      MURXLA_TEST(d_solver.check_sat_assuming(assumptions)
+      MURXLA_TEST(MURXLA_API_CALL(d_solver.check_sat_assuming(assumptions))
                   == Solver::Result::SAT);
     }
     if (size)
@@ -1683,8 +1684,8 @@ class BtorActionBvAssignment : public Action
   {
     MURXLA_TRACE << get_kind() << " " << term;
     BtorSolver& btor_solver = static_cast<BtorSolver&>(d_smgr.get_solver());
-    const char* assignment  = boolector_bv_assignment(
-        btor_solver.get_solver(), BtorTerm::get_btor_term(term));
+    const char* assignment  = MURXLA_API_CALL(boolector_bv_assignment(
+        btor_solver.get_solver(), BtorTerm::get_btor_term(term)));
     if (d_smgr.d_incremental)
     {
       /* assume assignment and check if result is still SAT */
@@ -1692,7 +1693,7 @@ class BtorActionBvAssignment : public Action
           d_solver.mk_value(term->get_sort(), assignment, Solver::Base::BIN);
       std::vector<Term> assumptions{
           d_solver.mk_term(Op::EQUAL, {term, term_bv_val}, {})};
-      MURXLA_TEST(d_solver.check_sat_assuming(assumptions)
+      MURXLA_TEST(MURXLA_API_CALL(d_solver.check_sat_assuming(assumptions))
                   == Solver::Result::SAT);
     }
     boolector_free_bv_assignment(btor_solver.get_solver(), assignment);
@@ -1741,7 +1742,8 @@ class BtorActionUFAssignment : public Action
     Btor* btor               = btor_solver.get_solver();
     char **args = nullptr, **values = nullptr;
     uint32_t size = 0;
-    boolector_uf_assignment(btor, btor_term, &args, &values, &size);
+    MURXLA_API_CALL(
+        boolector_uf_assignment(btor, btor_term, &args, &values, &size));
     if (d_smgr.d_incremental)
     {
       /* assume assignment and check if result is still SAT */
@@ -1769,7 +1771,7 @@ class BtorActionUFAssignment : public Action
             std::shared_ptr<BtorTerm>(new BtorTerm(btor, btor_eq)));
         boolector_release(btor, btor_eq);
       }
-      MURXLA_TEST(d_solver.check_sat_assuming(assumptions)
+      MURXLA_TEST(MURXLA_API_CALL(d_solver.check_sat_assuming(assumptions))
                   == Solver::Result::SAT);
     }
     if (size)
@@ -1809,6 +1811,8 @@ class BtorActionClone : public Action
   void run()
   {
     MURXLA_TRACE << get_kind();
+    /* This action consists of solver API calls and checks of their results. */
+    statistics::ActionTimer::ApiCall api(d_smgr.d_mbt_timer);
     BtorSolver& solver = static_cast<BtorSolver&>(d_smgr.get_solver());
     Btor* btor         = solver.get_solver();
     Btor* clone        = boolector_clone(btor);
@@ -1944,8 +1948,8 @@ class BtorActionFailed : public Action
   {
     MURXLA_TRACE << get_kind() << " " << term;
     BtorSolver& btor_solver = static_cast<BtorSolver&>(d_smgr.get_solver());
-    (void) boolector_failed(btor_solver.get_solver(),
-                            BtorTerm::get_btor_term(term));
+    (void) MURXLA_API_CALL(boolector_failed(btor_solver.get_solver(),
+                                            BtorTerm::get_btor_term(term)));
   }
 };
 
@@ -1983,8 +1987,8 @@ class BtorActionFixateAssumptions : public Action
   {
     MURXLA_TRACE << get_kind();
     reset_sat();
-    boolector_fixate_assumptions(
-        static_cast<BtorSolver&>(d_smgr.get_solver()).get_solver());
+    MURXLA_API_CALL(boolector_fixate_assumptions(
+        static_cast<BtorSolver&>(d_smgr.get_solver()).get_solver()));
   }
 };
 
@@ -2018,6 +2022,8 @@ class BtorActionOptIterator : public Action
   void run()
   {
     MURXLA_TRACE << get_kind();
+    /* This action consists of solver API calls and checks of their results. */
+    statistics::ActionTimer::ApiCall api(d_smgr.d_mbt_timer);
     Btor* btor = static_cast<BtorSolver&>(d_smgr.get_solver()).get_solver();
     for (BtorOption opt = boolector_first_opt(btor); opt < BTOR_OPT_NUM_OPTS;
          opt            = boolector_next_opt(btor, opt))
@@ -2079,8 +2085,8 @@ class BtorActionReleaseAll : public Action
   {
     MURXLA_TRACE << get_kind();
     d_smgr.clear();
-    boolector_release_all(
-        static_cast<BtorSolver&>(d_smgr.get_solver()).get_solver());
+    MURXLA_API_CALL(boolector_release_all(
+        static_cast<BtorSolver&>(d_smgr.get_solver()).get_solver()));
   }
 };
 
@@ -2118,8 +2124,8 @@ class BtorActionResetAssumptions : public Action
   {
     MURXLA_TRACE << get_kind();
     d_smgr.clear_assumptions();
-    boolector_reset_assumptions(
-        static_cast<BtorSolver&>(d_smgr.get_solver()).get_solver());
+    MURXLA_API_CALL(boolector_reset_assumptions(
+        static_cast<BtorSolver&>(d_smgr.get_solver()).get_solver()));
   }
 };
 
@@ -2159,7 +2165,8 @@ class BtorActionSetSatSolver : public Action
   {
     MURXLA_TRACE << get_kind() << " " << sat_solver;
     BtorSolver& solver = static_cast<BtorSolver&>(d_smgr.get_solver());
-    boolector_set_sat_solver(solver.get_solver(), sat_solver.c_str());
+    MURXLA_API_CALL(
+        boolector_set_sat_solver(solver.get_solver(), sat_solver.c_str()));
   }
 };
 
@@ -2196,8 +2203,8 @@ class BtorActionSimplify : public Action
   {
     MURXLA_TRACE << get_kind();
     reset_sat();
-    boolector_simplify(
-        static_cast<BtorSolver&>(d_smgr.get_solver()).get_solver());
+    MURXLA_API_CALL(boolector_simplify(
+        static_cast<BtorSolver&>(d_smgr.get_solver()).get_solver()));
   }
 };
 
@@ -2238,9 +2245,9 @@ class BtorActionSetSymbol : public Action
   {
     MURXLA_TRACE << get_kind() << " " << term << " \"" << symbol << "\"";
     BtorSolver& btor_solver = static_cast<BtorSolver&>(d_smgr.get_solver());
-    (void) boolector_set_symbol(btor_solver.get_solver(),
-                                BtorTerm::get_btor_term(term),
-                                symbol.c_str());
+    (void) MURXLA_API_CALL(boolector_set_symbol(btor_solver.get_solver(),
+                                                BtorTerm::get_btor_term(term),
+                                                symbol.c_str()));
   }
 };
 
@@ -2274,6 +2281,8 @@ class BtorActionMisc : public Action
   void run()
   {
     MURXLA_TRACE << get_kind();
+    /* This action consists of solver API calls and checks of their results. */
+    statistics::ActionTimer::ApiCall api(d_smgr.d_mbt_timer);
     BtorSolver& btor_solver = static_cast<BtorSolver&>(d_smgr.get_solver());
     Btor* btor              = btor_solver.get_solver();
 
@@ -2319,6 +2328,8 @@ class BtorActionPrintParse : public Action
   void run()
   {
     MURXLA_TRACE << get_kind();
+    /* This action consists of solver API calls and checks of their results. */
+    statistics::ActionTimer::ApiCall api(d_smgr.d_mbt_timer);
     BtorSolver& btor_solver = static_cast<BtorSolver&>(d_smgr.get_solver());
     Btor* btor              = btor_solver.get_solver();
     auto& rng               = btor_solver.get_rng();
@@ -1728,8 +1728,8 @@ class BzlaActionGetArrayValue : public Action
     const BitwuzlaTerm **bzla_idxs, **bzla_vals, *bzla_default_val;
     size_t size;
 
-    bitwuzla_get_array_value(
-        bzla, bzla_term, &bzla_idxs, &bzla_vals, &size, &bzla_default_val);
+    MURXLA_API_CALL(bitwuzla_get_array_value(
+        bzla, bzla_term, &bzla_idxs, &bzla_vals, &size, &bzla_default_val));
 
     if (d_smgr.d_incremental)
     {
@@ -1743,7 +1743,7 @@ class BzlaActionGetArrayValue : public Action
             bzla, BITWUZLA_KIND_EQUAL, bzla_select, bzla_vals[i]);
         assumptions.push_back(std::shared_ptr<BzlaTerm>(new BzlaTerm(bzla_eq)));
       }
-      MURXLA_TEST(d_solver.check_sat_assuming(assumptions)
+      MURXLA_TEST(MURXLA_API_CALL(d_solver.check_sat_assuming(assumptions))
                   == Solver::Result::SAT);
     }
   }
@@ -1789,7 +1789,8 @@ class BzlaActionGetBvValue : public Action
     BzlaSolver& bzla_solver       = dynamic_cast<BzlaSolver&>(d_solver);
     Bitwuzla* bzla                = bzla_solver.get_solver();
     const BitwuzlaTerm* bzla_term = BzlaTerm::get_bzla_term(term);
-    const char* bv_val            = bitwuzla_get_bv_value(bzla, bzla_term);
+    const char* bv_val =
+        MURXLA_API_CALL(bitwuzla_get_bv_value(bzla, bzla_term));
     if (d_smgr.d_incremental)
     {
       /* assume assignment and check if result is still SAT */
@@ -1797,7 +1798,7 @@ class BzlaActionGetBvValue : public Action
           d_solver.mk_value(term->get_sort(), bv_val, Solver::Base::BIN);
       std::vector<Term> assumptions{
           d_solver.mk_term(Op::EQUAL, {term, term_bv_val}, {})};
-      MURXLA_TEST(d_solver.check_sat_assuming(assumptions)
+      MURXLA_TEST(MURXLA_API_CALL(d_solver.check_sat_assuming(assumptions))
                   == Solver::Result::SAT);
     }
   }
@@ -1844,8 +1845,8 @@ class BzlaActionGetFpValue : public Action
     Bitwuzla* bzla                = bzla_solver.get_solver();
     const BitwuzlaTerm* bzla_term = BzlaTerm::get_bzla_term(term);
     const char *fp_val_sign, *fp_val_exp, *fp_val_sig;
-    bitwuzla_get_fp_value(
-        bzla, bzla_term, &fp_val_sign, &fp_val_exp, &fp_val_sig);
+    MURXLA_API_CALL(bitwuzla_get_fp_value(
+        bzla, bzla_term, &fp_val_sign, &fp_val_exp, &fp_val_sig));
     if (d_smgr.d_incremental)
     {
       /* assume assignment and check if result is still SAT */
@@ -1854,7 +1855,7 @@ class BzlaActionGetFpValue : public Action
       Term term_fp_val = d_solver.mk_value(term->get_sort(), fp_val);
       std::vector<Term> assumptions{
           d_solver.mk_term(Op::EQUAL, {term, term_fp_val}, {})};
-      MURXLA_TEST(d_solver.check_sat_assuming(assumptions)
+      MURXLA_TEST(MURXLA_API_CALL(d_solver.check_sat_assuming(assumptions))
                   == Solver::Result::SAT);
     }
   }
@@ -1903,8 +1904,8 @@ class BzlaActionGetFunValue : public Action
     const BitwuzlaTerm ***bzla_args, **bzla_vals;
     size_t arity, size;
 
-    bitwuzla_get_fun_value(
-        bzla, bzla_term, &bzla_args, &arity, &bzla_vals, &size);
+    MURXLA_API_CALL(bitwuzla_get_fun_value(
+        bzla, bzla_term, &bzla_args, &arity, &bzla_vals, &size));
 
     if (d_smgr.d_incremental)
     {
@@ -1927,7 +1928,7 @@ class BzlaActionGetFunValue : public Action
             bzla, BITWUZLA_KIND_EQUAL, bzla_apply, bzla_vals[i]);
         assumptions.push_back(std::shared_ptr<BzlaTerm>(new BzlaTerm(bzla_eq)));
       }
-      MURXLA_TEST(d_solver.check_sat_assuming(assumptions)
+      MURXLA_TEST(MURXLA_API_CALL(d_solver.check_sat_assuming(assumptions))
                   == Solver::Result::SAT);
     }
   }
@@ -1973,7 +1974,7 @@ class BzlaActionGetRmValue : public Action
     BzlaSolver& bzla_solver       = dynamic_cast<BzlaSolver&>(d_solver);
     Bitwuzla* bzla                = bzla_solver.get_solver();
     const BitwuzlaTerm* bzla_term = BzlaTerm::get_bzla_term(term);
-    std::string rm_val(bitwuzla_get_rm_value(bzla, bzla_term));
+    std::string rm_val(MURXLA_API_CALL(bitwuzla_get_rm_value(bzla, bzla_term)));
     if (d_smgr.d_incremental)
     {
       AbsTerm::SpecialValueKind value;
@@ -2002,7 +2003,7 @@ class BzlaActionGetRmValue : public Action
       Term term_rm_val = d_solver.mk_special_value(term->get_sort(), value);
       std::vector<Term> assumptions{
           d_solver.mk_term(Op::EQUAL, {term, term_rm_val}, {})};
-      MURXLA_TEST(d_solver.check_sat_assuming(assumptions)
+      MURXLA_TEST(MURXLA_API_CALL(d_solver.check_sat_assuming(assumptions))
                   == Solver::Result::SAT);
     }
   }
@@ -2048,8 +2049,8 @@ class BzlaActionIsUnsatAssumption : public Action
   {
     MURXLA_TRACE << get_kind() << " " << term;
     BzlaSolver& bzla_solver = dynamic_cast<BzlaSolver&>(d_solver);
-    (void) bitwuzla_is_unsat_assumption(bzla_solver.get_solver(),
-                                        BzlaTerm::get_bzla_term(term));
+    (void) MURXLA_API_CALL(bitwuzla_is_unsat_assumption(
+        bzla_solver.get_solver(), BzlaTerm::get_bzla_term(term)));
   }
 };
 
@@ -2087,8 +2088,8 @@ class BzlaActionFixateAssumptions : public Action
   {
     MURXLA_TRACE << get_kind();
     reset_sat();
-    bitwuzla_fixate_assumptions(
-        dynamic_cast<BzlaSolver&>(d_solver).get_solver());
+    MURXLA_API_CALL(bitwuzla_fixate_assumptions(
+        dynamic_cast<BzlaSolver&>(d_solver).get_solver()));
   }
 };
 
@@ -2126,8 +2127,8 @@ class BzlaActionResetAssumptions : public Action
   {
     MURXLA_TRACE << get_kind();
     d_smgr.clear_assumptions();
-    bitwuzla_reset_assumptions(
-        dynamic_cast<BzlaSolver&>(d_solver).get_solver());
+    MURXLA_API_CALL(bitwuzla_reset_assumptions(
+        dynamic_cast<BzlaSolver&>(d_solver).get_solver()));
   }
 };
 
@@ -2164,7 +2165,8 @@ class BzlaActionSimplify : public Action
   {
     MURXLA_TRACE << get_kind();
     reset_sat();
-    bitwuzla_simplify(dynamic_cast<BzlaSolver&>(d_solver).get_solver());
+    MURXLA_API_CALL(
+        bitwuzla_simplify(dynamic_cast<BzlaSolver&>(d_solver).get_solver()));
   }
 };
 
@@ -2278,11 +2280,11 @@ class BzlaActionSubstituteTerm : public Action
     if (bzla_terms.size() == 1 && d_rng.flip_coin())
     {
       const BitwuzlaTerm* bzla_res =
-          bitwuzla_substitute_term(bzla,
-                                   bzla_terms[0],
-                                   bzla_to_subst_terms.size(),
-                                   bzla_to_subst_terms.data(),
-                                   bzla_subst_terms.data());
+          MURXLA_API_CALL(bitwuzla_substitute_term(bzla,
+                                                   bzla_terms[0],
+                                                   bzla_to_subst_terms.size(),
+                                                   bzla_to_subst_terms.data(),
+                                                   bzla_subst_terms.data()));
       /* Note: The substituted term 'bzla_res' may or may not be already in the
        *       term DB. Since we can't always compute the exact level, we can't
        *       add the substituted term to the term DB. */
@@ -2290,12 +2292,12 @@ class BzlaActionSubstituteTerm : public Action
     }
     else
     {
-      bitwuzla_substitute_terms(bzla,
-                                bzla_terms.size(),
-                                bzla_terms.data(),
-                                bzla_to_subst_terms.size(),
-                                bzla_to_subst_terms.data(),
-                                bzla_subst_terms.data());
+      MURXLA_API_CALL(bitwuzla_substitute_terms(bzla,
+                                                bzla_terms.size(),
+                                                bzla_terms.data(),
+                                                bzla_to_subst_terms.size(),
+                                                bzla_to_subst_terms.data(),
+                                                bzla_subst_terms.data()));
     }
   }
 
@@ -2380,11 +2382,11 @@ class BzlaActionTermSetSymbol : public Action
   void run(Term term, std::string symbol)
   {
     MURXLA_TRACE << get_kind() << " " << term << " \"" << symbol << "\"";
-    (void) bitwuzla_term_set_symbol(BzlaTerm::get_bzla_term(term),
-                                    symbol.c_str());
-    MURXLA_TEST(
-        std::string(bitwuzla_term_get_symbol(BzlaTerm::get_bzla_term(term)))
-        == symbol);
+    (void) MURXLA_API_CALL(
+        bitwuzla_term_set_symbol(BzlaTerm::get_bzla_term(term), symbol.c_str()));
+    MURXLA_TEST(std::string(MURXLA_API_CALL(
+                    bitwuzla_term_get_symbol(BzlaTerm::get_bzla_term(term))))
+                == symbol);
   }
 };
 
@@ -2430,7 +2432,8 @@ class BzlaActionTermIsEqualSort : public Action
     const BitwuzlaTerm* bzla_term1 = BzlaTerm::get_bzla_term(term1);
     if (term0->get_sort()->equals(term1->get_sort()))
     {
-      MURXLA_TEST(bitwuzla_term_is_equal_sort(bzla_term0, bzla_term1));
+      MURXLA_TEST(MURXLA_API_CALL(
+          bitwuzla_term_is_equal_sort(bzla_term0, bzla_term1)));
     }
   }
   //! [docs-bzla-action-termisequalsort-run end]
@@ -2466,6 +2469,8 @@ class BzlaActionMisc : public Action
   void run()
   {
     MURXLA_TRACE << get_kind();
+    /* This action consists of solver API calls and checks of their results. */
+    statistics::ActionTimer::ApiCall api(d_smgr.d_mbt_timer);
     BzlaSolver& bzla_solver = dynamic_cast<BzlaSolver&>(d_smgr.get_solver());
     Bitwuzla* bzla          = bzla_solver.get_solver();
 
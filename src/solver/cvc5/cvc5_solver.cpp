@@ -38,9 +38,10 @@ namespace cvc5 {
       .get_tracer()([](Tracer<Cvc5TracerData>& tracer,                     \
                        auto&&... args) { tracer << "solver." << #FUNC; },  \
                     [this](auto&&... args) {                               \
-                      return static_cast<Cvc5Solver&>(d_smgr.get_solver()) \
-                          .get_solver()                                    \
-                          ->FUNC(args...);                                 \
+                      return MURXLA_API_CALL(                              \
+                          static_cast<Cvc5Solver&>(d_smgr.get_solver())    \
+                              .get_solver()                                \
+                              ->FUNC(args...));                            \
                     } __VA_OPT__(, ) __VA_ARGS__)
 
 #define TRACE_METHOD(FUNC, FIRST, ...)                      \
@@ -3140,9 +3141,10 @@ class Cvc5ActionSimplify : public Action
   {
     MURXLA_TRACE << get_kind() << " " << term;
     d_smgr.reset_sat();
-    Cvc5Solver& solver         = static_cast<Cvc5Solver&>(d_smgr.get_solver());
-    ::cvc5::Solver* cvc5       = solver.get_solver();
-    ::cvc5::Term cvc5_res      = cvc5->simplify(Cvc5Term::get_cvc5_term(term));
+    Cvc5Solver& solver    = static_cast<Cvc5Solver&>(d_smgr.get_solver());
+    ::cvc5::Solver* cvc5  = solver.get_solver();
+    ::cvc5::Term cvc5_res =
+        MURXLA_API_CALL(cvc5->simplify(Cvc5Term::get_cvc5_term(term)));
     MURXLA_TEST(!cvc5_res.isNull());
 
     /* Note: It is necessary for sequences to call Solver::simplify() to turn a
@@ -3152,7 +3154,7 @@ class Cvc5ActionSimplify : public Action
      */
     if (cvc5_res.isSequenceValue() && d_solver.get_rng().flip_coin())
     {
-      auto cvc5_seq_value = cvc5_res.getSequenceValue();
+      auto cvc5_seq_value = MURXLA_API_CALL(cvc5_res.getSequenceValue());
       for (const auto& t : cvc5_seq_value)
       {
         MURXLA_TEST(!t.isNull());
@@ -3205,7 +3207,7 @@ class Cvc5ActionGetDifficulty : public Action
     MURXLA_TRACE << get_kind();
     Cvc5Solver& solver        = static_cast<Cvc5Solver&>(d_smgr.get_solver());
     ::cvc5::Solver* cvc5      = solver.get_solver();
-    (void) cvc5->getDifficulty();
+    (void) MURXLA_API_CALL(cvc5->getDifficulty());
   }
 };
 
@@ -3266,7 +3268,7 @@ class Cvc5ActionGetInterpolant : public Action
     {
       do
       {
-        cvc5_res = cvc5->getInterpolantNext();
+        cvc5_res = MURXLA_API_CALL(cvc5->getInterpolantNext());
       } while (!cvc5_res.isNull() && d_solver.get_rng().flip_coin());
     }
   }
@@ -3543,12 +3545,13 @@ class Cvc5ActionSortSubstitute : public Action
     ::cvc5::Sort cvc5_res;
     if (to_subst_sorts.size() == 1 && d_solver.get_rng().flip_coin())
     {
-      cvc5_res =
-          cvc5_sort.substitute(cvc5_to_subst_sorts[0], cvc5_subst_sorts[0]);
+      cvc5_res = MURXLA_API_CALL(
+          cvc5_sort.substitute(cvc5_to_subst_sorts[0], cvc5_subst_sorts[0]));
     }
     else
     {
-      cvc5_res = cvc5_sort.substitute(cvc5_to_subst_sorts, cvc5_subst_sorts);
+      cvc5_res = MURXLA_API_CALL(
+          cvc5_sort.substitute(cvc5_to_subst_sorts, cvc5_subst_sorts));
     }
     MURXLA_TEST(!cvc5_res.isNull());
 
@@ -3742,12 +3745,13 @@ class Cvc5ActionTermSubstitute : public Action
     ::cvc5::Term cvc5_res;
     if (to_subst_terms.size() == 1 && d_rng.flip_coin())
     {
-      cvc5_res =
-          cvc5_term.substitute(cvc5_to_subst_terms[0], cvc5_subst_terms[0]);
+      cvc5_res = MURXLA_API_CALL(
+          cvc5_term.substitute(cvc5_to_subst_terms[0], cvc5_subst_terms[0]));
     }
     else
     {
-      cvc5_res = cvc5_term.substitute(cvc5_to_subst_terms, cvc5_subst_terms);
+      cvc5_res = MURXLA_API_CALL(
+          cvc5_term.substitute(cvc5_to_subst_terms, cvc5_subst_terms));
     }
     MURXLA_TEST(!cvc5_res.isNull());
     /* Note: The substituted term 'cvc5_res' may or may not be already in the
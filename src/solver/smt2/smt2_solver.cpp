@@ -488,7 +488,7 @@ Smt2Term::to_string() const
   return d_repr;
 }
 
-const std::string&
+const Op::Kind&
 Smt2Term::get_kind() const
 {
   return d_kind;
@@ -930,6 +930,10 @@ Smt2Solver::Smt2Solver(SolverSeedGenerator& sng,
       d_file_from(nullptr),
       d_solver_call(solver_binary)
 {
+  /* Start symbol numbering from scratch for each solver instance, else
+   * multiple test runs within the same process (persistent mode) would not
+   * produce the same output as when run in a separate process. */
+  Smt2Sort::reset_symbol_cnt();
 }
 
 Smt2Solver::~Smt2Solver()
@@ -1695,7 +1699,7 @@ Smt2Solver::get_sort(Term term, SortKind sort_kind)
 
 #ifdef MURXLA_USE_CVC5
   /* cvc5 solver-specific operators */
-  if (kind.rfind("cvc5-", 0) == 0)
+  if (kind.str().rfind("cvc5-", 0) == 0)
   {
     if (kind == cvc5::Cvc5Term::OP_BV_REDAND
         || kind == cvc5::Cvc5Term::OP_BV_REDOR)
@@ -1871,7 +1875,7 @@ Smt2Solver::get_sort(Term term, SortKind sort_kind)
         bv_size = params[0];
         sort    = get_bv_sort_string(bv_size);
       }
-      else if (kind.rfind("OP_BV_", 0) == 0)
+      else if (kind.str().rfind("OP_BV_", 0) == 0)
       {
         // return sort of first operand for non-solver-specific bv operators
         return args[0]->get_sort();
@@ -73,6 +73,9 @@ class Smt2Sort : public AbsSort
   const std::string& get_repr() const;
   void set_symbol(const std::string& symbol);
 
+  /** Reset the counter of freshly introduced sort symbols. */
+  static void reset_symbol_cnt() { s_symbol_cnt = 0; }
+
  private:
   /**
    * The counter of sort symbols that have been freshly introduced. Used to
@@ -116,7 +119,7 @@ class Smt2Term : public AbsTerm
   bool equals(const Term& other) const override;
   std::string to_string() const override;
 
-  const std::string& get_kind() const override;
+  const Op::Kind& get_kind() const override;
   std::vector<Term> get_children() const override;
   const std::vector<Term>& get_args() const;
   const std::vector<std::string>& get_str_args() const;
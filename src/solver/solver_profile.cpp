@@ -110,24 +110,35 @@ SolverProfile::merge(const std::string& json_str1, const std::string& json_str2)
   return j1.dump();
 }
 
-TheoryVector
+const TheoryVector&
 SolverProfile::get_supported_theories() const
 {
-  TheorySet solver_theories;
-  for (const std::string& t : get_array({KEY_THEORIES, "include"}, true))
+  if (!d_supported_theories)
   {
-    solver_theories.insert(to_theory(t));
-  }
-  // THEORY_BOOL is always enabled.
-  solver_theories.insert(THEORY_BOOL);
+    TheorySet solver_theories;
+    for (const std::string& t : get_array({KEY_THEORIES, "include"}, true))
+    {
+      solver_theories.insert(to_theory(t));
+    }
+    // THEORY_BOOL is always enabled.
+    solver_theories.insert(THEORY_BOOL);
 
-  return TheoryVector(solver_theories.begin(), solver_theories.end());
+    d_supported_theories.emplace(solver_theories.begin(),
+                                 solver_theories.end());
+  }
+  return *d_supported_theories;
 }
 
-std::unordered_map<Theory, std::vector<Theory>>
+const SolverProfile::TheoryCombinationMap&
 SolverProfile::get_unsupported_theory_combinations() const
 {
-  std::unordered_map<Theory, std::vector<Theory>> unsupported;
+  if (d_unsupported_theory_combinations)
+  {
+    return *d_unsupported_theory_combinations;
+  }
+
+  TheoryCombinationMap& unsupported =
+      d_unsupported_theory_combinations.emplace();
 
   auto it = d_json.find(KEY_THEORIES);
   if (it != d_json.end())
@@ -157,10 +168,15 @@ SolverProfile::get_unsupported_theory_combinations() const
   return unsupported;
 }
 
-OpKindSet
+const OpKindSet&
 SolverProfile::get_unsupported_op_kinds() const
 {
-  OpKindSet unsupported;
+  if (d_unsupported_op_kinds)
+  {
+    return *d_unsupported_op_kinds;
+  }
+
+  OpKindSet& unsupported = d_unsupported_op_kinds.emplace();
   if (has_key(KEY_OPERATORS))
   {
     auto kinds = get_array({KEY_OPERATORS, "exclude"});
@@ -170,23 +186,30 @@ SolverProfile::get_unsupported_op_kinds() const
   return unsupported;
 }
 
-SolverProfile::OpKindSortKindMap
+const SolverProfile::OpKindSortKindMap&
 SolverProfile::get_unsupported_op_sort_kinds() const
 {
+  if (d_unsupported_op_sort_kinds)
+  {
+    return *d_unsupported_op_sort_kinds;
+  }
+
   auto it = d_json.find(KEY_OPERATORS);
   if (it == d_json.end())
   {
-    return d_default_unsupported_op_sort_kinds;
+    return d_unsupported_op_sort_kinds.emplace(
+        d_default_unsupported_op_sort_kinds);
   }
   auto itt = it->find(KEY_SORT_RESTR);
   if (itt == it->end())
   {
-    return d_default_unsupported_op_sort_kinds;
+    return d_unsupported_op_sort_kinds.emplace(
+        d_default_unsupported_op_sort_kinds);
   }
   MURXLA_EXIT_ERROR(!itt->is_object())
       << "Expected JSON object for `" << KEY_SORT_RESTR << "'";
 
-  OpKindSortKindMap unsupported;
+  OpKindSortKindMap& unsupported = d_unsupported_op_sort_kinds.emplace();
   for (auto i = itt->begin(); i != itt->end(); ++i)
   {
     Op::Kind k = i.key();
@@ -203,134 +226,140 @@ SolverProfile::get_unsupported_op_sort_kinds() const
   return unsupported;
 }
 
-SortKindSet
+const SortKindSet&
 SolverProfile::get_unsupported_sort_kinds() const
 {
   return get_sort_kinds({KEY_SORTS, "exclude"});
 }
 
-SortKindSet
+const SortKindSet&
 SolverProfile::get_unsupported_var_sort_kinds() const
 {
   return get_sort_kinds({KEY_SORTS, "var", "exclude"});
 }
 
-SortKindSet
+const SortKindSet&
 SolverProfile::get_unsupported_array_index_sort_kinds() const
 {
   return get_sort_kinds({KEY_SORTS, "array-index", "exclude"});
 }
 
-SortKindSet
+const SortKindSet&
 SolverProfile::get_unsupported_array_element_sort_kinds() const
 {
   return get_sort_kinds({KEY_SORTS, "array-element", "exclude"});
 }
 
-SortKindSet
+const SortKindSet&
 SolverProfile::get_unsupported_bag_element_sort_kinds() const
 {
   return get_sort_kinds({KEY_SORTS, "bag-element", "exclude"});
 }
 
-SortKindSet
+const SortKindSet&
 SolverProfile::get_unsupported_dt_match_sort_kinds() const
 {
   return get_sort_kinds({KEY_SORTS, "datatype-match", "exclude"});
 }
 
-SortKindSet
+const SortKindSet&
 SolverProfile::get_unsupported_dt_sel_codomain_sort_kinds() const
 {
   return get_sort_kinds({KEY_SORTS, "datatype-selector-codomain", "exclude"});
 }
 
-SortKindSet
+const SortKindSet&
 SolverProfile::get_unsupported_fun_codomain_sort_kinds() const
 {
   return get_sort_kinds({KEY_SORTS, "fun-codomain", "exclude"});
 }
 
-SortKindSet
+const SortKindSet&
 SolverProfile::get_unsupported_fun_domain_sort_kinds() const
 {
   return get_sort_kinds({KEY_SORTS, "fun-domain", "exclude"});
 }
 
-SortKindSet
+const SortKindSet&
 SolverProfile::get_unsupported_fun_sort_codomain_sort_kinds() const
 {
   return get_sort_kinds({KEY_SORTS, "fun-sort-codomain", "exclude"});
 }
 
-SortKindSet
+const SortKindSet&
 SolverProfile::get_unsupported_fun_sort_domain_sort_kinds() const
 {
   return get_sort_kinds({KEY_SORTS, "fun-sort-domain", "exclude"});
 }
 
-SortKindSet
+const SortKindSet&
 SolverProfile::get_unsupported_get_value_sort_kinds() const
 {
   return get_sort_kinds({KEY_SORTS, "get-value", "exclude"});
 }
 
-SortKindSet
+const SortKindSet&
 SolverProfile::get_unsupported_seq_element_sort_kinds() const
 {
   return get_sort_kinds({KEY_SORTS, "seq-element", "exclude"});
 }
 
-SortKindSet
+const SortKindSet&
 SolverProfile::get_unsupported_set_element_sort_kinds() const
 {
   return get_sort_kinds({KEY_SORTS, "set-element", "exclude"});
 }
 
-SortKindSet
+const SortKindSet&
 SolverProfile::get_unsupported_sort_param_sort_kinds() const
 {
   return get_sort_kinds({KEY_SORTS, "sort-param", "exclude"});
 }
 
-std::vector<std::string>
+const std::vector<std::string>&
 SolverProfile::get_excluded_errors() const
 {
-  std::vector<std::string> errors;
-  // Load excluded errors
-  auto it = d_json.find(KEY_ERRORS);
-  if (it != d_json.end())
+  if (!d_excluded_errors)
   {
-    auto itt = it->find("exclude");
-    if (itt != it->end() && itt->is_array())
-    {
-      for (const auto& err : *itt)
-      {
-        errors.emplace_back(err.get<std::string>());
-      }
-    }
+    d_excluded_errors = get_errors("exclude");
   }
-  return errors;
+  return *d_excluded_errors;
 }
 
-std::vector<std::string>
+const std::vector<std::string>&
 SolverProfile::get_error_filters() const
 {
-  std::vector<std::string> filters;
-  // Load error filters
-  auto it = d_json.find(KEY_ERRORS);
-  if (it != d_json.end())
+  if (!d_error_filters)
   {
-    auto itt = it->find("filter");
-    if (itt != it->end() && itt->is_array())
-    {
-      for (const auto& err : *itt)
-      {
-        filters.emplace_back(err.get<std::string>());
-      }
-    }
+    d_error_filters = get_errors("filter");
   }
-  return filters;
+  return *d_error_filters;
+}
+
+void
+SolverProfile::populate_cache() const
+{
+  get_supported_theories();
+  get_unsupported_theory_combinations();
+  get_unsupported_op_kinds();
+  get_unsupported_op_sort_kinds();
+  get_unsupported_sort_kinds();
+  get_unsupported_var_sort_kinds();
+  get_unsupported_array_index_sort_kinds();
+  get_unsupported_array_element_sort_kinds();
+  get_unsupported_bag_element_sort_kinds();
+  get_unsupported_dt_match_sort_kinds();
+  get_unsupported_dt_sel_codomain_sort_kinds();
+  get_unsupported_fun_codomain_sort_kinds();
+  get_unsupported_fun_domain_sort_kinds();
+  get_unsupported_fun_sort_codomain_sort_kinds();
+  get_unsupported_fun_sort_domain_sort_kinds();
+  get_unsupported_get_value_sort_kinds();
+  get_unsupported_seq_element_sort_kinds();
+  get_unsupported_set_element_sort_kinds();
+  get_unsupported_sort_param_sort_kinds();
+  get_excluded_errors();
+  get_error_filters();
 }
 
 void
@@ -401,11 +430,18 @@ SolverProfile::get_array(const std::vector<std::string>& keys,
   return res;
 }
 
-SortKindSet
+const SortKindSet&
 SolverProfile::get_sort_kinds(const std::vector<std::string>& keys,
                               bool required) const
 {
-  SortKindSet kinds;
+  std::string key = join(keys, "::");
+  auto it         = d_sort_kinds.find(key);
+  if (it != d_sort_kinds.end())
+  {
+    return it->second;
+  }
+
+  SortKindSet& kinds = d_sort_kinds[key];
   for (const auto& k : get_array(keys, required))
   {
     kinds.insert(to_sort_kind(k));
@@ -413,4 +449,23 @@ SolverProfile::get_sort_kinds(const std::vector<std::string>& keys,
   return kinds;
 }
 
+std::vector<std::string>
+SolverProfile::get_errors(const std::string& key) const
+{
+  std::vector<std::string> errors;
+  auto it = d_json.find(KEY_ERRORS);
+  if (it != d_json.end())
+  {
+    auto itt = it->find(key);
+    if (itt != it->end() && itt->is_array())
+    {
+      for (const auto& err : *itt)
+      {
+        errors.emplace_back(err.get<std::string>());
+      }
+    }
+  }
+  return errors;
+}
+
 }  // namespace murxla
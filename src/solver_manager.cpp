@@ -87,15 +87,95 @@ SolverManager::clear()
   d_string_char_values.clear();
   d_untraced_terms.clear();
   d_untraced_sorts.clear();
+  d_op_sort_kinds.clear();
   reset_op_cache();
 }
 
 void
 SolverManager::reset_op_cache()
 {
-  const auto& kinds = d_opmgr->get_op_kinds();
-  d_available_op_kinds.insert(kinds.begin(), kinds.end());
-  d_enabled_op_kinds.clear();
+  d_op_kind_reqs.clear();
+  for (const auto& [kind, op] : d_opmgr->get_op_kinds())
+  {
+    OpKindRequirements reqs;
+    reqs.d_op         = &op;
+    reqs.d_sort_kinds = TermDb::get_sort_kind_mask(op.d_sort_kinds);
+    /* Quantifiers can only be created if we already have variables and
+     * Boolean terms in the current scope. */
+    reqs.d_quant = op.d_kind == Op::FORALL || op.d_kind == Op::EXISTS
+                   || op.d_kind == Op::SET_COMPREHENSION;
+    size_t n_args = op.d_arity < 0 ? 1 : op.d_arity;
+    for (size_t i = 0; i < n_args; ++i)
+    {
+      TermDb::SortKindMask mask =
+          TermDb::get_sort_kind_mask(op.get_arg_sort_kind(i));
+      if (std::find(
+              reqs.d_arg_sort_kinds.begin(), reqs.d_arg_sort_kinds.end(), mask)
+          == reqs.d_arg_sort_kinds.end())
+      {
+        reqs.d_arg_sort_kinds.push_back(mask);
+      }
+    }
+    d_op_kind_reqs.push_back(std::move(reqs));
+  }
+  for (auto& index : d_op_kind_index)
+  {
+    index.d_state = std::numeric_limits<uint64_t>::max();
+  }
+}
+
+uint64_t
+SolverManager::get_op_kind_index_state() const
+{
+  bool quant = d_term_db.has_var() && d_term_db.has_quant_body()
+               && d_term_db.get_num_terms(d_term_db.max_level())
+                      >= MURXLA_MIN_N_QUANT_TERMS;
+  return (static_cast<uint64_t>(d_term_db.get_sort_kinds()) << 1) | quant;
+}
+
+void
+SolverManager::build_op_kind_index(OpKindIndex& index,
+                                   SortKind sort_kind,
+                                   uint64_t state)
+{
+  auto sort_kinds = static_cast<TermDb::SortKindMask>(state >> 1);
+  bool quant      = state & 1;
+
+  for (auto& ops : index.d_ops)
+  {
+    ops.clear();
+  }
+  index.d_theories.clear();
+
+  for (const auto& reqs : d_op_kind_reqs)
+  {
+    if (reqs.d_quant && !quant) continue;
+    if (sort_kind != SORT_ANY
+        && !(reqs.d_sort_kinds & TermDb::get_sort_kind_mask(sort_kind)))
+    {
+      continue;
+    }
+    /* Check if we already have terms that can be used with this operator. */
+    bool has_terms = true;
+    for (TermDb::SortKindMask mask : reqs.d_arg_sort_kinds)
+    {
+      if (!(sort_kinds & mask))
+      {
+        has_terms = false;
+        break;
+      }
+    }
+    if (!has_terms) continue;
+
+    Theory theory = reqs.d_op->d_theory;
+    auto& ops     = index.d_ops[theory];
+    if (ops.empty() && theory != THEORY_BOOL && theory != THEORY_ALL)
+    {
+      index.d_theories.push_back(theory);
+    }
+    ops.push_back(reqs.d_op);
+  }
+  index.d_state = state;
 }
 
 /* -------------------------------------------------------------------------- */
@@ -260,6 +340,16 @@ SolverManager::add_term(Term& term,
   assert(d_enabled_theories.find(THEORY_SEQ) == d_enabled_theories.end()
          || term->get_kind() != Op::UNDEFINED);
   const Op::Kind kind = term->get_kind();
+  if (kind.get_id() >= d_op_sort_kinds.size())
+  {
+    d_op_sort_kinds.resize(Op::Kind::get_num_ids(), 0);
+  }
+  uint32_t& sort_kinds = d_op_sort_kinds[kind.get_id()];
+  if (!(sort_kinds & (1u << sort_kind)))
+  {
+    sort_kinds |= 1u << sort_kind;
+    d_stats.op_sorts += 1;
+  }
   if ((kind == Op::BAG_TO_SET || kind == Op::BAG_FROM_SET
        || kind == Op::BAG_MAKE || kind == Op::BAG_MAP || kind == Op::SEQ_UNIT
        || kind == Op::SET_SINGLETON || kind == Op::SET_COMPREHENSION)
@@ -442,117 +532,50 @@ SolverManager::pick_op_kind(bool with_terms, SortKind sort_kind)
 {
   if (with_terms)
   {
-    std::unordered_map<Theory, OpKindSet> kinds(d_enabled_op_kinds);
-    std::vector<Op::Kind> remove;
-    for (const auto& [kind, op] : d_available_op_kinds)
+    /* The index only changes when the sort kinds with terms or the
+     * quantifier scope change, rebuild it lazily. */
+    OpKindIndex& index = d_op_kind_index[sort_kind];
+    uint64_t state     = get_op_kind_index_state();
+    if (index.d_state != state)
     {
-      /* Quantifiers can only be created if we already have variables and
-       * Boolean terms in the current scope. */
-      if ((op.d_kind == Op::FORALL || op.d_kind == Op::EXISTS
-           || op.d_kind == Op::SET_COMPREHENSION)
-          && (!d_term_db.has_var() || !d_term_db.has_quant_body()
-              || (d_term_db.get_num_terms(d_term_db.max_level())
-                  < MURXLA_MIN_N_QUANT_TERMS)))
-      {
-        continue;
-      }
-
-      bool has_terms = true;
-
-      /* Check if we already have terms that can be used with this operator. */
-      if (op.d_arity < 0)
-      {
-        has_terms = has_term(op.get_arg_sort_kind(0));
-      }
-      else
-      {
-        for (size_t i = 0; i < (size_t) op.d_arity; ++i)
-        {
-          if (!has_term(op.get_arg_sort_kind(i)))
-          {
-            has_terms = false;
-            break;
-          }
-        }
-      }
-      if (has_terms)
-      {
-        /* In general if a term was added to the term db it will always be
-         * available. However, for quantifiers, terms get "consumed" and
-         * therefore we always have to check whether we can create a quantified
-         * term and therefore the FORALL and EXISTS kinds can't be cached. */
-        if (op.d_kind != Op::FORALL && op.d_kind != Op::EXISTS)
-        {
-          d_enabled_op_kinds[op.d_theory].insert(op.d_kind);
-          remove.push_back(op.d_kind);
-        }
-        kinds[op.d_theory].insert(op.d_kind);
-      }
+      build_op_kind_index(index, sort_kind, state);
     }
 
-    /* Remove the enabled kinds from d_available_op_kinds since these kinds now
-     * can be constructed with terms in the db. */
-    for (const auto& k : remove)
+    bool have_bool = !index.d_ops[THEORY_BOOL].empty();
+    bool have_all  = !index.d_ops[THEORY_ALL].empty();
+    if (index.d_theories.empty() && !have_bool && !have_all)
     {
-      d_available_op_kinds.erase(k);
+      /* We cannot create any operation with the current set of terms. */
+      return Op::UNDEFINED;
     }
 
-    /* Filter operator kinds based on sort kind. */
-    if (sort_kind != SORT_ANY)
+    /* First pick theory and then operator kind (avoids bias against theories
+     * with many operators). However, we pick THEORY_BOOL and THEORY_ALL with
+     * lower probability (10% each) to generate more theory terms. */
+    uint32_t prob = have_all ? 900 : 1000;
+    if (have_bool)
     {
-      const auto& enabled_ops = d_opmgr->get_op_kinds();
-      for (const auto& [kind, op] : enabled_ops)
-      {
-        if (op.d_sort_kinds.find(sort_kind) == op.d_sort_kinds.end())
-        {
-          const auto it = kinds.find(op.d_theory);
-          if (it != kinds.end())
-          {
-            it->second.erase(kind);
-            if (it->second.empty())
-            {
-              kinds.erase(op.d_theory);
-            }
-          }
-        }
-      }
+      prob -= 100;
     }
 
-    if (kinds.size() > 0)
+    Theory theory = THEORY_ALL;
+    if (!index.d_theories.empty() && d_rng.pick_with_prob(prob))
     {
-      /* First pick theory and then operator kind (avoids bias against theories
-       * with many operators). However, we pick THEORY_BOOL and THEORY_ALL with
-       * lower probability (10% each) to generate more theory terms. */
-
-      bool have_bool  = kinds.find(THEORY_BOOL) != kinds.end();
-      bool have_all   = kinds.find(THEORY_ALL) != kinds.end();
-      size_t min_size = have_all ? 1 : 0;
-      uint32_t prob   = have_all ? 900 : 1000;
-      if (have_bool)
-      {
-        min_size += 1;
-        prob -= 100;
-      }
-
-      Theory theory = THEORY_ALL;
-      if (kinds.size() > min_size && d_rng.pick_with_prob(prob))
-      {
-        do
-        {
-          theory = d_rng.pick_from_map<decltype(kinds), Theory>(kinds);
-        } while (theory == THEORY_ALL || theory == THEORY_BOOL);
-      }
-      else if (have_bool && d_rng.flip_coin())
-      {
-        theory = THEORY_BOOL;
-      }
-
-      auto& op_kinds  = kinds[theory];
-      return d_rng.pick_from_set<decltype(op_kinds), Op::Kind>(op_kinds);
+      theory = d_rng.pick_from_set<decltype(index.d_theories), Theory>(
+          index.d_theories);
+    }
+    else if (have_bool && (!have_all || d_rng.flip_coin()))
+    {
+      theory = THEORY_BOOL;
+    }
+    else if (!have_all)
+    {
+      theory = d_rng.pick_from_set<decltype(index.d_theories), Theory>(
+          index.d_theories);
     }
 
-    /* We cannot create any operation with the current set of terms. */
-    return Op::UNDEFINED;
+    const auto& ops = index.d_ops[theory];
+    return d_rng.pick_from_set<std::vector<const Op*>, const Op*>(ops)->d_kind;
   }
 
   if (sort_kind == SORT_ANY)
@@ -700,7 +723,6 @@ void
 SolverManager::remove_var(const Term& var)
 {
   d_term_db.remove_var(var);
-  reset_op_cache();
 }
 
 Term
@@ -10,6 +10,7 @@
 #ifndef __MURXLA__SOLVER_MANAGER_H
 #define __MURXLA__SOLVER_MANAGER_H
 
+#include <array>
 #include <cassert>
 #include <iostream>
 #include <memory>
@@ -20,16 +21,13 @@
 #include "solver/solver_profile.hpp"
 #include "solver_option.hpp"
 #include "sort.hpp"
+#include "statistics.hpp"
 #include "term_db.hpp"
 #include "theory.hpp"
 #include "util.hpp"
 
 namespace murxla {
 
-namespace statistics {
-struct Statistics;
-}
-
 /* -------------------------------------------------------------------------- */
 
 class SolverManager
@@ -43,10 +41,11 @@ class SolverManager
   /* Statistics. */
   struct Stats
   {
-    uint32_t inputs = 0; /* values, constants */
-    uint32_t vars   = 0; /* variables */
-    uint32_t terms  = 0; /* all terms, including inputs */
-    uint32_t sorts  = 0; /* all sorts */
+    uint32_t inputs   = 0; /* values, constants */
+    uint32_t vars     = 0; /* variables */
+    uint32_t terms    = 0; /* all terms, including inputs */
+    uint32_t sorts    = 0; /* all sorts */
+    uint32_t op_sorts = 0; /* combinations of operator and sort kind */
   };
 
 
@@ -841,10 +840,18 @@ class SolverManager
   /** The number of check-sat calls issued. */
   uint32_t d_n_sat_calls = 0;
 
+  /**
+   * The sort kinds of the terms created per operator kind, as a bit mask
+   * indexed by sort kind. Indexed by the id of the operator kind.
+   */
+  std::vector<uint32_t> d_op_sort_kinds;
+
   /* Statistics ------------------------------------------------------------- */
 
   /** A pointer to the murxla-level statistics object. */
   statistics::Statistics* d_mbt_stats;
+  /** The timer for the murxla-level action and operator times. */
+  statistics::ActionTimer d_mbt_timer;
 
  private:
   /**
@@ -1061,16 +1068,62 @@ class SolverManager
   std::unordered_map<uint64_t, Sort> d_untraced_sorts;
 
   /**
-   * Cache used by pick_op_kind. Caches operator kinds that are currently
-   * safe to pick since the required terms to create an operator already exist.
+   * The requirements of an operator kind on the terms in the term database,
+   * as sort kind masks (see TermDb::SortKindMask).
+   */
+  struct OpKindRequirements
+  {
+    /** The operator. */
+    const Op* d_op;
+    /** The sort kinds of the created terms. */
+    TermDb::SortKindMask d_sort_kinds;
+    /** The sort kinds of the arguments, one mask per distinct argument. */
+    std::vector<TermDb::SortKindMask> d_arg_sort_kinds;
+    /** True if this kind requires a quantifier body in the current scope. */
+    bool d_quant;
+  };
+
+  /**
+   * Index of the operator kinds that can currently be created with the terms
+   * in the term database, grouped by theory.
+   */
+  struct OpKindIndex
+  {
+    /** The state of the term database this index was built for. */
+    uint64_t d_state = std::numeric_limits<uint64_t>::max();
+    /** Maps theory to the operators of that theory in this index. */
+    std::array<std::vector<const Op*>, THEORY_ALL + 1> d_ops;
+    /** The theories in this index except THEORY_BOOL and THEORY_ALL. */
+    std::vector<Theory> d_theories;
+  };
+
+  /**
+   * Get the state of the term database that determines which operator kinds
+   * can be created, i.e., the sort kinds with terms and whether quantifiers
+   * can be created in the current scope.
+   */
+  uint64_t get_op_kind_index_state() const;
+
+  /**
+   * Rebuild given index of operator kinds (optionally restricted to operators
+   * that create terms of given sort kind) for given term database state.
+   */
+  void build_op_kind_index(OpKindIndex& index,
+                           SortKind sort_kind,
+                           uint64_t state);
+
+  /**
+   * Cache used by pick_op_kind. The requirements of all operator kinds
+   * reported by opmgr.
    */
-  std::unordered_map<Theory, OpKindSet> d_enabled_op_kinds;
+  std::vector<OpKindRequirements> d_op_kind_reqs;
 
   /**
-   * Cache used by pick_op_kind. Caches available operator kinds reported
-   * by opmgr, but cannot be constructed yet due to missing terms.
+   * Cache used by pick_op_kind. Maps sort kind to the index of operator kinds
+   * that create terms of that sort kind (SORT_ANY for all operator kinds).
+   * Indices are rebuilt lazily when the state of the term database changes.
    */
-  OpKindMap d_available_op_kinds;
+  std::array<OpKindIndex, SORT_ANY + 1> d_op_kind_index;
 
   /** Is this solver manager already initialized? */
   bool d_initialized = false;
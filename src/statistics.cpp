@@ -9,12 +9,125 @@
  */
 #include "statistics.hpp"
 
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
 #include "op.hpp"
 #include "solver/solver.hpp"
 
 namespace murxla {
 namespace statistics {
 
+/* -------------------------------------------------------------------------- */
+
+namespace {
+
+/** Format given time in nanoseconds with an appropriate unit. */
+std::string
+format_time(double ns)
+{
+  std::stringstream ss;
+  ss << std::fixed << std::setprecision(2);
+  if (ns >= 1000000000)
+  {
+    ss << ns / 1000000000 << "s";
+  }
+  else if (ns >= 1000000)
+  {
+    ss << ns / 1000000 << "ms";
+  }
+  else
+  {
+    ss << ns / 1000 << "us";
+  }
+  return ss.str();
+}
+
+/**
+ * Print the times spent in Murxla and in solver API calls per kind, ordered
+ * by total time.
+ * kinds : The kinds.
+ * gen   : The histograms of the time spent in Murxla per kind.
+ * api   : The histograms of the time spent in solver API calls per kind.
+ * n     : The maximum number of kinds.
+ */
+void
+print_times(const char kinds[][MURXLA_MAX_KIND_LEN],
+            const LatencyHistogram* gen,
+            const LatencyHistogram* api,
+            uint32_t n)
+{
+  std::vector<uint32_t> ids;
+  for (uint32_t i = 0; i < n && kinds[i][0]; ++i)
+  {
+    if (gen[i].d_count) ids.push_back(i);
+  }
+  std::sort(ids.begin(), ids.end(), [&](uint32_t a, uint32_t b) {
+    return gen[a].d_sum + api[a].d_sum > gen[b].d_sum + api[b].d_sum;
+  });
+  for (uint32_t i : ids)
+  {
+    double cnt = static_cast<double>(gen[i].d_count);
+    std::cout << "  " << kinds[i] << ": total "
+              << format_time(static_cast<double>(gen[i].d_sum)) << " / "
+              << format_time(static_cast<double>(api[i].d_sum)) << ", mean "
+              << format_time(static_cast<double>(gen[i].d_sum) / cnt)
+              << " / " << format_time(static_cast<double>(api[i].d_sum) / cnt)
+              << ", p99 "
+              << format_time(static_cast<double>(gen[i].percentile(0.99)))
+              << " / "
+              << format_time(static_cast<double>(api[i].percentile(0.99)))
+              << std::endl;
+  }
+}
+
+}  // namespace
+
+/* -------------------------------------------------------------------------- */
+
+void
+Statistics::merge(const Statistics& other)
+{
+  auto merge_kind = [](char* kind, const char* other_kind) {
+    if (!kind[0]) strncpy(kind, other_kind, MURXLA_MAX_KIND_LEN);
+  };
+
+  for (uint32_t i = 0; i < 3; ++i)
+  {
+    d_results[i] += other.d_results[i];
+  }
+  for (uint32_t i = 0; i < MURXLA_MAX_N_OPS; ++i)
+  {
+    merge_kind(d_op_kinds[i], other.d_op_kinds[i]);
+    d_ops[i] += other.d_ops[i];
+    d_ops_ok[i] += other.d_ops_ok[i];
+    d_op_gen_time[i].merge(other.d_op_gen_time[i]);
+    d_op_api_time[i].merge(other.d_op_api_time[i]);
+  }
+  for (uint32_t i = 0; i < SORT_ANY; ++i)
+  {
+    d_sorts[i] += other.d_sorts[i];
+    d_sorts_ok[i] += other.d_sorts_ok[i];
+  }
+  for (uint32_t i = 0; i < MURXLA_MAX_N_STATES; ++i)
+  {
+    merge_kind(d_state_kinds[i], other.d_state_kinds[i]);
+    d_states[i] += other.d_states[i];
+  }
+  for (uint32_t i = 0; i < MURXLA_MAX_N_ACTIONS; ++i)
+  {
+    merge_kind(d_action_kinds[i], other.d_action_kinds[i]);
+    d_actions[i] += other.d_actions[i];
+    d_actions_ok[i] += other.d_actions_ok[i];
+    d_action_gen_time[i].merge(other.d_action_gen_time[i]);
+    d_action_api_time[i].merge(other.d_action_api_time[i]);
+  }
+  d_cpu_time.merge(other.d_cpu_time);
+  d_max_rss.merge(other.d_max_rss);
+}
+
 void
 Statistics::print() const
 {
@@ -41,6 +154,12 @@ Statistics::print() const
   }
   std::cout << "  Total: " << sum << " (" << sum_ok << ")" << std::endl;
 
+  std::cout << "Action times (murxla / solver):" << std::endl;
+  print_times(d_action_kinds,
+              d_action_gen_time,
+              d_action_api_time,
+              MURXLA_MAX_N_ACTIONS);
+
   sum = 0;
   std::cout << "Results:" << std::endl;
   for (uint32_t i = 0; i < 3; ++i)
@@ -62,6 +181,9 @@ Statistics::print() const
   }
   std::cout << "  Total: " << sum << " (" << sum_ok << ")" << std::endl;
 
+  std::cout << "Op times (murxla / solver):" << std::endl;
+  print_times(d_op_kinds, d_op_gen_time, d_op_api_time, MURXLA_MAX_N_OPS);
+
   sum = 0, sum_ok = 0;
   std::cout << "Sorts:" << std::endl;
   for (uint32_t i = 0; i < SORT_ANY; ++i)
@@ -72,7 +194,79 @@ Statistics::print() const
     sum_ok += d_sorts_ok[i];
   }
   std::cout << "  Total: " << sum << " (" << sum_ok << ")" << std::endl;
+
+  if (d_cpu_time.d_count > 0)
+  {
+    auto print_percentiles = [](const Histogram& h, double unit) {
+      auto get = [&](double p) {
+        return static_cast<double>(p < 1 ? h.percentile(p) : h.d_max) / unit;
+      };
+      std::cout << std::fixed << std::setprecision(2);
+      std::cout << "p50 " << get(0.5) << ", p90 " << get(0.9) << ", p99 "
+                << get(0.99) << ", max " << get(1) << std::endl;
+      std::cout << std::defaultfloat;
+    };
+    std::cout << "Resources:" << std::endl;
+    std::cout << "  Runs: " << d_cpu_time.d_count << std::endl;
+    std::cout << "  CPU time (s): ";
+    print_percentiles(d_cpu_time, 1000000.0);
+    std::cout << "  Max RSS (MiB): ";
+    print_percentiles(d_max_rss, 1024.0);
+  }
+}
+
+/* -------------------------------------------------------------------------- */
+
+void
+ActionTimer::start()
+{
+  d_running     = true;
+  d_api_running = false;
+  d_api_time    = Clock::duration::zero();
+  d_op_id.reset();
+  d_start = Clock::now();
 }
 
+void
+ActionTimer::start_api_call()
+{
+  if (!d_running) return;
+  d_api_running = true;
+  d_api_start   = Clock::now();
+}
+
+void
+ActionTimer::stop_api_call()
+{
+  if (!d_api_running) return;
+  d_api_running = false;
+  d_api_time += Clock::now() - d_api_start;
+}
+
+void
+ActionTimer::stop(Statistics* stats, uint64_t action_id)
+{
+  stop_api_call();
+  d_running = false;
+
+  auto total = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   Clock::now() - d_start)
+                   .count();
+  auto api =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(d_api_time).count();
+  uint64_t api_time = static_cast<uint64_t>(api);
+  uint64_t gen_time = total > api ? static_cast<uint64_t>(total - api) : 0;
+
+  stats->d_action_gen_time[action_id].add(gen_time);
+  stats->d_action_api_time[action_id].add(api_time);
+  if (d_op_id)
+  {
+    stats->d_op_gen_time[*d_op_id].add(gen_time);
+    stats->d_op_api_time[*d_op_id].add(api_time);
+  }
+}
+
+/* -------------------------------------------------------------------------- */
+
 }  // namespace statistics
 }  // namespace murxla
@@ -10,6 +10,12 @@
 #ifndef __MURXLA__STATISTICS_H
 #define __MURXLA__STATISTICS_H
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <optional>
+
 #include "config.hpp"
 #include "op.hpp"
 
@@ -17,13 +23,112 @@ namespace murxla {
 
 namespace statistics {
 
+/**
+ * Histogram over non-negative integer values with logarithmic buckets.
+ *
+ * Values are bucketed by their most significant bits, i.e., by the position
+ * of their leading one and the SUB_BITS bits after it (2^SUB_BITS buckets
+ * per power of two). Located in shared memory, we thus only use base types
+ * here.
+ */
+template <uint32_t SUB_BITS>
+struct LogHistogram
+{
+  /** The number of buckets. */
+  static constexpr uint32_t NUM_BUCKETS = (64 - SUB_BITS + 1) << SUB_BITS;
+
+  uint64_t d_buckets[NUM_BUCKETS];
+  uint64_t d_count;
+  uint64_t d_sum;
+  uint64_t d_max;
+
+  /** Add given value. */
+  void add(uint64_t value)
+  {
+    uint32_t idx = static_cast<uint32_t>(value);
+    if (value >= (1u << SUB_BITS))
+    {
+      uint32_t msb = 63 - static_cast<uint32_t>(__builtin_clzll(value));
+      uint32_t sub = (value >> (msb - SUB_BITS)) & ((1u << SUB_BITS) - 1);
+      idx          = ((msb - SUB_BITS + 1) << SUB_BITS) + sub;
+    }
+    d_buckets[idx] += 1;
+    d_count += 1;
+    d_sum += value;
+    if (value > d_max) d_max = value;
+  }
+
+  /** Add the values of given histogram. */
+  void merge(const LogHistogram& other)
+  {
+    for (uint32_t i = 0; i < NUM_BUCKETS; ++i)
+    {
+      d_buckets[i] += other.d_buckets[i];
+    }
+    d_count += other.d_count;
+    d_sum += other.d_sum;
+    if (other.d_max > d_max) d_max = other.d_max;
+  }
+
+  /**
+   * Get the given percentile of the added values.
+   * Returns the upper bound of the bucket the percentile falls into (at most
+   * the maximum added value), 0 if no values were added.
+   * p: The percentile in [0, 1].
+   */
+  uint64_t percentile(double p) const
+  {
+    if (d_count == 0) return 0;
+
+    uint64_t rank =
+        static_cast<uint64_t>(std::ceil(p * static_cast<double>(d_count)));
+    if (rank == 0) rank = 1;
+
+    uint64_t cnt = 0;
+    for (uint32_t i = 0; i < NUM_BUCKETS; ++i)
+    {
+      cnt += d_buckets[i];
+      if (cnt >= rank)
+      {
+        uint64_t upper = i;
+        if (i >= (1u << SUB_BITS))
+        {
+          uint32_t shift = (i >> SUB_BITS) - 1;
+          uint64_t sub   = i & ((1u << SUB_BITS) - 1);
+          upper          = (((1ull << SUB_BITS) + sub) << shift)
+                  + ((1ull << shift) - 1);
+        }
+        return std::min(upper, d_max);
+      }
+    }
+    return d_max;
+  }
+};
+
+/**
+ * Histogram for resource usage of test runs, percentiles are accurate up to a
+ * relative error of 12.5%.
+ */
+using Histogram = LogHistogram<3>;
+/**
+ * Histogram for latencies of actions and operators, percentiles are accurate
+ * up to a factor of 2. Kept small since there is one per action and operator
+ * kind.
+ */
+using LatencyHistogram = LogHistogram<0>;
+
 /**
  * Statistics.
  *
  * The main statistics object is located in shared memory. We thus only use
  * base types here.
+ *
+ * Statistics are sharded: each process that records statistics concurrently
+ * to other processes (test runs of parallel workers in continuous mode)
+ * records into a separate shard, and shards are aggregated via merge() for
+ * printing. Shards are cache-line aligned to not share cache lines.
  */
-struct Statistics
+struct alignas(64) Statistics
 {
   uint64_t d_results[3];
   char d_op_kinds[MURXLA_MAX_N_OPS][MURXLA_MAX_KIND_LEN];
@@ -36,10 +141,103 @@ struct Statistics
   char d_action_kinds[MURXLA_MAX_N_ACTIONS][MURXLA_MAX_KIND_LEN];
   uint64_t d_actions[MURXLA_MAX_N_ACTIONS];
   uint64_t d_actions_ok[MURXLA_MAX_N_ACTIONS];
+  /** The time spent generating actions in Murxla in nanoseconds. */
+  LatencyHistogram d_action_gen_time[MURXLA_MAX_N_ACTIONS];
+  /** The time spent in solver API calls of actions in nanoseconds. */
+  LatencyHistogram d_action_api_time[MURXLA_MAX_N_ACTIONS];
+  /** The time spent generating terms in Murxla per operator in nanoseconds. */
+  LatencyHistogram d_op_gen_time[MURXLA_MAX_N_OPS];
+  /** The time spent in solver API calls per operator in nanoseconds. */
+  LatencyHistogram d_op_api_time[MURXLA_MAX_N_OPS];
+  /** The CPU time of test runs in microseconds (continuous mode). */
+  Histogram d_cpu_time;
+  /** The peak resident set size of test runs in KiB (continuous mode). */
+  Histogram d_max_rss;
+
+  /**
+   * Add the counters of given statistics (shard) to this statistics object.
+   * Kinds not registered in this statistics object are taken from `other`.
+   */
+  void merge(const Statistics& other);
 
   void print() const;
 };
 
+/**
+ * Timer that splits the time of an action into the time spent in Murxla
+ * (generating, tracing and checking the action) and the time spent in solver
+ * API calls.
+ *
+ * Solver API calls are timed explicitly by the actions, via MURXLA_API_CALL.
+ */
+class ActionTimer
+{
+ public:
+  /** Times a solver API call for the lifetime of this object. */
+  class ApiCall
+  {
+   public:
+    /** Constructor, marks the start of a solver API call. */
+    ApiCall(ActionTimer& timer)
+        : d_timer(timer), d_nested(timer.d_api_running)
+    {
+      if (!d_nested) d_timer.start_api_call();
+    }
+    /** Destructor, marks the end of the solver API call. */
+    ~ApiCall()
+    {
+      if (!d_nested) d_timer.stop_api_call();
+    }
+
+   private:
+    /** The associated timer. */
+    ActionTimer& d_timer;
+    /** True if this call is timed as part of an enclosing API call. */
+    bool d_nested;
+  };
+
+  /** Start timing an action. */
+  void start();
+  /** Mark the start of a solver API call, ignored if not timing an action. */
+  void start_api_call();
+  /** Mark the end of the current solver API call, if any. */
+  void stop_api_call();
+  /**
+   * Execute given solver API call and time it.
+   * Returns the result of the call.
+   */
+  template <class Call>
+  decltype(auto) time_api_call(Call&& call)
+  {
+    ApiCall api(*this);
+    return call();
+  }
+  /** Set the operator of the current action (ActionMkTerm). */
+  void set_op(uint64_t op_id) { d_op_id = op_id; }
+  /**
+   * Stop timing the current action and record its times.
+   * stats    : The statistics to record the times in.
+   * action_id: The id of the action.
+   */
+  void stop(Statistics* stats, uint64_t action_id);
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  /** True if an action is timed. */
+  bool d_running = false;
+  /** True if a solver API call is timed. */
+  bool d_api_running = false;
+  /** The start time of the current action. */
+  Clock::time_point d_start;
+  /** The start time of the current solver API call. */
+  Clock::time_point d_api_start;
+  /** The time spent in solver API calls of the current action so far. */
+  Clock::duration d_api_time;
+  /** The operator of the current action, if any. */
+  std::optional<uint64_t> d_op_id;
+};
+
 }  // namespace statistics
 }  // namespace murxla
 #endif
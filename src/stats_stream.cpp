@@ -0,0 +1,168 @@
+/***
+ * Murxla: A Model-Based API Fuzzer for SMT solvers.
+ *
+ * This file is part of Murxla.
+ *
+ * Copyright (C) 2019-2022 by the authors listed in the AUTHORS file.
+ *
+ * See LICENSE for more information on using this software.
+ */
+#include "stats_stream.hpp"
+
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+#include "except.hpp"
+
+namespace murxla {
+
+/* -------------------------------------------------------------------------- */
+
+namespace {
+
+/**
+ * Write to given file descriptor with SIGPIPE blocked, such that writing to a
+ * FIFO whose reader went away fails with EPIPE instead of terminating the
+ * process. A SIGPIPE raised by the write is discarded.
+ */
+ssize_t
+write_nosignal(int32_t fd, const char* buf, size_t size)
+{
+  sigset_t sigpipe, old_mask, pending;
+  sigemptyset(&sigpipe);
+  sigaddset(&sigpipe, SIGPIPE);
+  sigpending(&pending);
+  bool was_pending = sigismember(&pending, SIGPIPE);
+  sigprocmask(SIG_BLOCK, &sigpipe, &old_mask);
+
+  ssize_t res = ::write(fd, buf, size);
+  if (res < 0 && errno == EPIPE && !was_pending)
+  {
+    int32_t err            = errno;
+    struct timespec nowait = {0, 0};
+    while (sigtimedwait(&sigpipe, nullptr, &nowait) < 0 && errno == EINTR)
+    {
+    }
+    errno = err;
+  }
+
+  sigprocmask(SIG_SETMASK, &old_mask, nullptr);
+  return res;
+}
+
+}  // namespace
+
+/* -------------------------------------------------------------------------- */
+
+StatsStream::StatsStream(const std::string& target)
+{
+  size_t len = strlen(UNIX_PREFIX);
+  if (target.compare(0, len, UNIX_PREFIX) == 0)
+  {
+    d_path      = target.substr(len);
+    d_is_socket = true;
+    MURXLA_EXIT_ERROR(d_path.size() >= sizeof(sockaddr_un::sun_path))
+        << "socket path for statistics stream '" << d_path << "' too long";
+  }
+  else
+  {
+    d_path = target;
+  }
+  /* A FIFO without a reader yet is opened when the next record is written. */
+  MURXLA_EXIT_ERROR(!open() && (d_is_socket || errno != ENXIO))
+      << "unable to open statistics stream '" << target
+      << "': " << strerror(errno);
+}
+
+StatsStream::~StatsStream() { close(); }
+
+void
+StatsStream::write(const std::string& record)
+{
+  /* Complete a partially written record first to keep lines intact. */
+  if ((d_fd < 0 && !open()) || !flush())
+  {
+    d_num_dropped += 1;
+    return;
+  }
+  d_pending = record + "\n";
+  size_t size = d_pending.size();
+  if (!flush() && (d_fd < 0 || d_pending.size() == size))
+  {
+    d_pending.clear();
+    d_num_dropped += 1;
+  }
+}
+
+bool
+StatsStream::flush()
+{
+  while (!d_pending.empty())
+  {
+    ssize_t n =
+        d_is_socket
+            ? send(d_fd, d_pending.data(), d_pending.size(), MSG_NOSIGNAL)
+            : write_nosignal(d_fd, d_pending.data(), d_pending.size());
+    if (n < 0 && errno == EINTR) continue;
+    /* The reader does not keep up, never block the caller. */
+    if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return false;
+    if (n <= 0)
+    {
+      /* The reader went away (EPIPE) or the connection failed, reopen or
+       * reconnect on the next record. */
+      close();
+      return false;
+    }
+    d_pending.erase(0, static_cast<size_t>(n));
+  }
+  return true;
+}
+
+bool
+StatsStream::open()
+{
+  if (!d_is_socket)
+  {
+    d_fd = ::open(d_path.c_str(),
+                  O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC | O_NONBLOCK,
+                  0644);
+    return d_fd >= 0;
+  }
+
+  d_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0);
+  if (d_fd < 0) return false;
+
+  struct sockaddr_un addr = {};
+  addr.sun_family         = AF_UNIX;
+  strncpy(addr.sun_path, d_path.c_str(), sizeof(addr.sun_path) - 1);
+  if (connect(d_fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr))
+      != 0)
+  {
+    int32_t err = errno;
+    close();
+    errno = err;
+    return false;
+  }
+  return true;
+}
+
+void
+StatsStream::close()
+{
+  if (d_fd >= 0)
+  {
+    ::close(d_fd);
+    d_fd = -1;
+  }
+  d_pending.clear();
+}
+
+/* -------------------------------------------------------------------------- */
+
+}  // namespace murxla
@@ -0,0 +1,83 @@
+/***
+ * Murxla: A Model-Based API Fuzzer for SMT solvers.
+ *
+ * This file is part of Murxla.
+ *
+ * Copyright (C) 2019-2022 by the authors listed in the AUTHORS file.
+ *
+ * See LICENSE for more information on using this software.
+ */
+#ifndef __MURXLA__STATS_STREAM_H
+#define __MURXLA__STATS_STREAM_H
+
+#include <cstdint>
+#include <string>
+
+namespace murxla {
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * Line-oriented output stream for machine-readable statistics records.
+ *
+ * The target is either a file (or FIFO), which is appended to, or a Unix
+ * domain socket given as `unix:<path>`, which must be listening. If writing
+ * to the FIFO or socket fails (e.g., the reader went away), the record is
+ * dropped and opening the FIFO or connecting to the socket is retried when
+ * the next record is written.
+ *
+ * Writing never blocks: the target is written to in non-blocking mode, and
+ * records that can not be written since the reader does not keep up are
+ * dropped (and counted).
+ */
+class StatsStream
+{
+ public:
+  /** The prefix of targets that denote a Unix domain socket. */
+  static constexpr const char* UNIX_PREFIX = "unix:";
+
+  /**
+   * Constructor.
+   * target: The file name or `unix:<path>` of the socket to write to.
+   */
+  StatsStream(const std::string& target);
+  /** Destructor. */
+  ~StatsStream();
+
+  StatsStream(const StatsStream&) = delete;
+  StatsStream& operator=(const StatsStream&) = delete;
+
+  /** Write given record as one line, or drop it if the target is busy. */
+  void write(const std::string& record);
+
+  /** Get the number of records dropped so far. */
+  uint64_t get_num_dropped() const { return d_num_dropped; }
+
+ private:
+  /** Open the file or connect to the socket. Returns true on success. */
+  bool open();
+  /**
+   * Write the pending part of the current record.
+   * Returns true if it was written completely.
+   */
+  bool flush();
+  /** Close the file or socket. */
+  void close();
+
+  /** The file name or the path of the socket. */
+  std::string d_path;
+  /** True if the target is a Unix domain socket. */
+  bool d_is_socket = false;
+  /** The file descriptor of the target, -1 if not open. */
+  int32_t d_fd = -1;
+  /** The part of the current record that was not written yet. */
+  std::string d_pending;
+  /** The number of dropped records. */
+  uint64_t d_num_dropped = 0;
+};
+
+/* -------------------------------------------------------------------------- */
+
+}  // namespace murxla
+
+#endif
@@ -0,0 +1,354 @@
+/***
+ * Murxla: A Model-Based API Fuzzer for SMT solvers.
+ *
+ * This file is part of Murxla.
+ *
+ * Copyright (C) 2019-2022 by the authors listed in the AUTHORS file.
+ *
+ * See LICENSE for more information on using this software.
+ */
+#include "supervisor.hpp"
+
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/syscall.h>
+#include <sys/timerfd.h>
+#endif
+
+#include <cassert>
+#include <cerrno>
+#include <cmath>
+#include <vector>
+
+#include "except.hpp"
+
+namespace murxla {
+
+/* -------------------------------------------------------------------------- */
+
+namespace {
+
+#ifdef __linux__
+int32_t
+pidfd_open(pid_t pid)
+{
+#ifdef SYS_pidfd_open
+  return static_cast<int32_t>(syscall(SYS_pidfd_open, pid, 0));
+#else
+  (void) pid;
+  return -1;
+#endif
+}
+#endif
+
+/** The interval in seconds for polling processes without a pidfd. */
+const double POLL_INTERVAL = 0.001;
+
+}  // namespace
+
+/* -------------------------------------------------------------------------- */
+
+Supervisor::Supervisor() { init(); }
+
+Supervisor::~Supervisor() { close_fds(); }
+
+void
+Supervisor::reset()
+{
+  /* The epoll instance and the timer are shared with the parent process and
+   * must not be modified, only the file descriptors of the current process
+   * are closed. */
+  close_fds();
+  d_procs.clear();
+  d_pidfd_to_pid.clear();
+  d_deadlines.clear();
+  d_events.clear();
+  d_epollfd = -1;
+  d_timerfd = -1;
+  init();
+}
+
+void
+Supervisor::init()
+{
+#ifdef __linux__
+  d_epollfd = epoll_create1(EPOLL_CLOEXEC);
+  if (d_epollfd >= 0)
+  {
+    d_timerfd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK);
+    if (d_timerfd >= 0)
+    {
+      struct epoll_event ev = {};
+      ev.events             = EPOLLIN;
+      ev.data.fd            = d_timerfd;
+      if (epoll_ctl(d_epollfd, EPOLL_CTL_ADD, d_timerfd, &ev) != 0)
+      {
+        close(d_timerfd);
+        d_timerfd = -1;
+      }
+    }
+    if (d_timerfd < 0)
+    {
+      close(d_epollfd);
+      d_epollfd = -1;
+    }
+  }
+#endif
+}
+
+void
+Supervisor::close_fds()
+{
+  for (const auto& [pid, proc] : d_procs)
+  {
+    if (proc.d_pidfd >= 0) close(proc.d_pidfd);
+  }
+  if (d_timerfd >= 0) close(d_timerfd);
+  if (d_epollfd >= 0) close(d_epollfd);
+}
+
+void
+Supervisor::add(pid_t pid, double time)
+{
+  assert(d_procs.find(pid) == d_procs.end());
+  Process& proc = d_procs[pid];
+#ifdef __linux__
+  if (d_epollfd >= 0)
+  {
+    proc.d_pidfd = pidfd_open(pid);
+    if (proc.d_pidfd >= 0)
+    {
+      struct epoll_event ev = {};
+      ev.events             = EPOLLIN;
+      ev.data.fd            = proc.d_pidfd;
+      MURXLA_CHECK(epoll_ctl(d_epollfd, EPOLL_CTL_ADD, proc.d_pidfd, &ev) == 0)
+          << "failed to watch process " << pid;
+      d_pidfd_to_pid.emplace(proc.d_pidfd, pid);
+    }
+  }
+#endif
+  set_timeout(pid, time);
+}
+
+void
+Supervisor::remove(pid_t pid)
+{
+  auto it = d_procs.find(pid);
+  if (it != d_procs.end())
+  {
+    clear_deadline(pid);
+    if (it->second.d_pidfd >= 0)
+    {
+      /* Closing the pidfd also removes it from the epoll instance. */
+      d_pidfd_to_pid.erase(it->second.d_pidfd);
+      close(it->second.d_pidfd);
+    }
+    d_procs.erase(it);
+  }
+  for (auto eit = d_events.begin(); eit != d_events.end();)
+  {
+    eit = eit->d_pid == pid ? d_events.erase(eit) : std::next(eit);
+  }
+}
+
+void
+Supervisor::set_timeout(pid_t pid, double time)
+{
+  assert(d_procs.find(pid) != d_procs.end());
+  clear_deadline(pid);
+  if (time > 0)
+  {
+    double deadline            = get_time() + time;
+    d_procs.at(pid).d_deadline = deadline;
+    d_deadlines.emplace(deadline, pid);
+  }
+}
+
+std::optional<Supervisor::Event>
+Supervisor::wait(double max_wait, pid_t pid)
+{
+  double end = max_wait < 0 ? -1 : get_time() + max_wait;
+  for (;;)
+  {
+    poll();
+    for (auto it = d_events.begin(); it != d_events.end(); ++it)
+    {
+      if (pid == 0 || it->d_pid == pid)
+      {
+        Event event = *it;
+        d_events.erase(it);
+        return event;
+      }
+    }
+    assert(pid == 0 || d_procs.find(pid) != d_procs.end());
+
+    double remaining = -1;
+    if (end >= 0)
+    {
+      remaining = end - get_time();
+      if (remaining <= 0)
+      {
+        return std::nullopt;
+      }
+    }
+    if (!block(remaining))
+    {
+      return std::nullopt;
+    }
+  }
+}
+
+double
+Supervisor::get_cpu_time(const struct rusage& rusage)
+{
+  return static_cast<double>(rusage.ru_utime.tv_sec + rusage.ru_stime.tv_sec)
+         + static_cast<double>(rusage.ru_utime.tv_usec
+                               + rusage.ru_stime.tv_usec)
+               / 1000000;
+}
+
+double
+Supervisor::get_time()
+{
+  struct timespec ts;
+  MURXLA_EXIT_ERROR(clock_gettime(CLOCK_MONOTONIC, &ts) != 0)
+      << "failed to get time";
+  return static_cast<double>(ts.tv_sec)
+         + static_cast<double>(ts.tv_nsec) / 1000000000;
+}
+
+void
+Supervisor::poll()
+{
+  double now = get_time();
+  while (!d_deadlines.empty() && d_deadlines.begin()->first <= now)
+  {
+    pid_t pid = d_deadlines.begin()->second;
+    clear_deadline(pid);
+    d_events.push_back({EventKind::TIMEOUT, pid, 0, {}});
+  }
+
+  std::vector<pid_t> polled;
+  for (const auto& [pid, proc] : d_procs)
+  {
+    if (proc.d_pidfd < 0) polled.push_back(pid);
+  }
+  for (pid_t pid : polled)
+  {
+    collect(pid);
+  }
+}
+
+bool
+Supervisor::block(double max_wait)
+{
+  bool has_polled  = d_procs.size() > d_pidfd_to_pid.size();
+  double wait_time = max_wait;
+  if (has_polled && (wait_time < 0 || wait_time > POLL_INTERVAL))
+  {
+    wait_time = POLL_INTERVAL;
+  }
+
+#ifdef __linux__
+  if (d_epollfd >= 0)
+  {
+    /* Arm timer for the next deadline. */
+    struct itimerspec its = {};
+    if (!d_deadlines.empty())
+    {
+      double deadline = d_deadlines.begin()->first;
+      double secs     = std::floor(deadline);
+
+      its.it_value.tv_sec  = static_cast<time_t>(secs);
+      its.it_value.tv_nsec = static_cast<long>((deadline - secs) * 1000000000);
+      /* A zero value would disarm the timer. */
+      if (its.it_value.tv_sec == 0 && its.it_value.tv_nsec == 0)
+      {
+        its.it_value.tv_nsec = 1;
+      }
+    }
+    MURXLA_CHECK(timerfd_settime(d_timerfd, TFD_TIMER_ABSTIME, &its, nullptr)
+                 == 0)
+        << "failed to arm timer";
+
+    int32_t timeout_ms =
+        wait_time < 0 ? -1
+                      : static_cast<int32_t>(std::ceil(wait_time * 1000));
+    struct epoll_event events[64];
+    int32_t n = epoll_wait(d_epollfd, events, 64, timeout_ms);
+    if (n < 0)
+    {
+      MURXLA_CHECK(errno == EINTR) << "failed to wait for child processes";
+      return false;
+    }
+    for (int32_t i = 0; i < n; ++i)
+    {
+      int32_t fd = events[i].data.fd;
+      if (fd == d_timerfd)
+      {
+        uint64_t expirations;
+        (void) read(d_timerfd, &expirations, sizeof(expirations));
+        continue;
+      }
+      auto it = d_pidfd_to_pid.find(fd);
+      if (it != d_pidfd_to_pid.end())
+      {
+        collect(it->second);
+      }
+    }
+    return true;
+  }
+#endif
+
+  if (!d_deadlines.empty())
+  {
+    double next = d_deadlines.begin()->first - get_time();
+    if (wait_time < 0 || next < wait_time)
+    {
+      wait_time = next;
+    }
+  }
+  if (wait_time < 0 || wait_time > POLL_INTERVAL)
+  {
+    wait_time = POLL_INTERVAL;
+  }
+  if (wait_time > 0)
+  {
+    return usleep(static_cast<useconds_t>(wait_time * 1000000)) == 0;
+  }
+  return true;
+}
+
+bool
+Supervisor::collect(pid_t pid)
+{
+  int32_t status       = 0;
+  struct rusage rusage = {};
+  pid_t res            = wait4(pid, &status, WNOHANG, &rusage);
+  MURXLA_CHECK(res >= 0) << "failed to wait for process " << pid;
+  if (res == 0)
+  {
+    return false;
+  }
+  remove(pid);
+  d_events.push_back({EventKind::EXIT, pid, status, rusage});
+  return true;
+}
+
+void
+Supervisor::clear_deadline(pid_t pid)
+{
+  auto it = d_procs.find(pid);
+  if (it != d_procs.end() && it->second.d_deadline > 0)
+  {
+    d_deadlines.erase(std::make_pair(it->second.d_deadline, pid));
+    it->second.d_deadline = 0;
+  }
+}
+
+/* -------------------------------------------------------------------------- */
+
+}  // namespace murxla
@@ -0,0 +1,171 @@
+/***
+ * Murxla: A Model-Based API Fuzzer for SMT solvers.
+ *
+ * This file is part of Murxla.
+ *
+ * Copyright (C) 2019-2022 by the authors listed in the AUTHORS file.
+ *
+ * See LICENSE for more information on using this software.
+ */
+#ifndef __MURXLA__SUPERVISOR_H
+#define __MURXLA__SUPERVISOR_H
+
+#include <sys/resource.h>
+#include <sys/types.h>
+
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <set>
+#include <unordered_map>
+
+namespace murxla {
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * Supervisor for forked child processes (test runs).
+ *
+ * Watches an arbitrary number of child processes for termination and
+ * time limits without additional timeout processes. On Linux, this is
+ * implemented via an epoll loop over one pidfd per child process and a single
+ * timerfd that is armed to the earliest deadline. On other platforms (or if
+ * pidfd_open is not supported by the kernel), child processes are polled.
+ */
+class Supervisor
+{
+ public:
+  /** The kind of an event of a watched child process. */
+  enum class EventKind
+  {
+    /** The process terminated and was collected. */
+    EXIT,
+    /** The process exceeded its time limit, it is still running. */
+    TIMEOUT,
+  };
+
+  /** An event of a watched child process. */
+  struct Event
+  {
+    /** The kind of the event. */
+    EventKind d_kind;
+    /** The pid of the process. */
+    pid_t d_pid;
+    /** The exit status of the process (EventKind::EXIT only). */
+    int32_t d_status;
+    /** The resource usage of the process (EventKind::EXIT only). */
+    struct rusage d_rusage;
+  };
+
+  /** Constructor. */
+  Supervisor();
+  /** Destructor. */
+  ~Supervisor();
+
+  /**
+   * Watch given child process.
+   * pid : The pid of the child process.
+   * time: The time limit in seconds, 0 for no time limit.
+   */
+  void add(pid_t pid, double time);
+
+  /**
+   * Stop watching given child process.
+   * Pending events of the process are discarded. This does not collect the
+   * process.
+   */
+  void remove(pid_t pid);
+
+  /**
+   * Set the time limit of a watched child process, starting from now.
+   * pid : The pid of the child process.
+   * time: The time limit in seconds, 0 for no time limit.
+   */
+  void set_timeout(pid_t pid, double time);
+
+  /**
+   * Wait for the next event of a watched child process.
+   *
+   * A timeout event is only reported once, the time limit of the process is
+   * removed when it is reported. A process remains watched until it
+   * terminated or was removed via remove().
+   *
+   * max_wait: The maximum time to wait in seconds, a negative value to block
+   *           until the next event.
+   * pid     : If not 0, only wait for events of the given process. Events of
+   *           other processes are kept and reported by subsequent calls.
+   *
+   * Returns the event, or std::nullopt if no event occurred within
+   * `max_wait` seconds or if waiting was interrupted by a signal.
+   */
+  std::optional<Event> wait(double max_wait, pid_t pid = 0);
+
+  /**
+   * Stop watching all child processes and discard all pending events.
+   * This is called in a forked child process to supervise its own child
+   * processes, the inherited state is shared with the parent process.
+   */
+  void reset();
+
+  /** Get the CPU time (user and system) of given resource usage in seconds. */
+  static double get_cpu_time(const struct rusage& rusage);
+
+  /** Return true if no child process is watched. */
+  bool empty() const { return d_procs.empty(); }
+
+ private:
+  /** Data of a watched process. */
+  struct Process
+  {
+    /** The pidfd of the process, -1 if pidfds are not supported. */
+    int32_t d_pidfd = -1;
+    /** The deadline of the process, 0 if no time limit. */
+    double d_deadline = 0;
+  };
+
+  /** Create the epoll instance and the timer, if supported. */
+  void init();
+  /** Close all file descriptors of this supervisor. */
+  void close_fds();
+
+  /** Get the current time of the monotonic clock in seconds. */
+  static double get_time();
+
+  /**
+   * Check for an expired deadline and collect terminated processes.
+   * Pushes resulting events to the queue of pending events.
+   */
+  void poll();
+  /**
+   * Block until the next deadline, until a watched process terminated, or
+   * at most `max_wait` seconds.
+   * Returns false if blocking was interrupted by a signal.
+   */
+  bool block(double max_wait);
+  /**
+   * Collect given process if it terminated.
+   * Returns true if the process was collected.
+   */
+  bool collect(pid_t pid);
+  /** Remove the time limit of given process. */
+  void clear_deadline(pid_t pid);
+
+  /** The watched processes. Maps pid to process data. */
+  std::unordered_map<pid_t, Process> d_procs;
+  /** Maps pidfd to pid. */
+  std::unordered_map<int32_t, pid_t> d_pidfd_to_pid;
+  /** The deadlines of watched processes, ordered by deadline. */
+  std::set<std::pair<double, pid_t>> d_deadlines;
+  /** The events that occurred but were not reported yet. */
+  std::deque<Event> d_events;
+  /** The epoll instance, -1 if not supported. */
+  int32_t d_epollfd = -1;
+  /** The timer to wake up at the next deadline, -1 if not supported. */
+  int32_t d_timerfd = -1;
+};
+
+/* -------------------------------------------------------------------------- */
+
+}  // namespace murxla
+
+#endif
@@ -17,35 +17,27 @@
 
 namespace murxla {
 
-const static size_t MURXLA_PICK_MAX_WEIGHT = std::numeric_limits<size_t>::max();
-
-TermRefs::TermRefs(size_t level)
-{
-  for (size_t i = 0; i < level; ++i)
-  {
-    d_levels.push_back(0);
-  }
-}
+TermRefs::TermRefs(size_t level) : d_levels(level) {}
 
 void
 TermRefs::add(const Term& t, size_t level)
 {
   assert(level < d_levels.size());
 
-  if (d_idx.find(t) == d_idx.end())
+  if (d_idx.emplace(t, level).second)
   {
-    d_idx.emplace(t, d_refs.size());
-
-    size_t end = get_level_end(level);
-
-    ++d_levels[level];
-    d_terms.insert(d_terms.begin() + end, t);
-    d_refs.insert(d_refs.begin() + end, 0);
-
-    /* Initialize weight to maximum weight for new terms. Will be recomputed as
-     * soon as term is picked once. This ensures that new terms are picked with
-     * a very high probability. */
-    d_weights.insert(d_weights.begin() + end, MURXLA_PICK_MAX_WEIGHT);
+    /* New terms are fresh, i.e., picked first until they are picked once or
+     * the epoch ends. This ensures that new terms are picked with a very high
+     * probability. */
+    Level& l = d_levels[level];
+    if (l.d_epoch != d_epoch)
+    {
+      l.d_epoch_begin = l.d_terms.size();
+      l.d_epoch       = d_epoch;
+    }
+    l.d_terms.push_back(t);
+    l.d_refs.push_back(0);
+    l.d_fresh.push_back(1);
   }
 }
 
@@ -69,48 +61,90 @@ TermRefs::get(const Term& t) const
 Term
 TermRefs::pick(RNGenerator& rng, size_t level)
 {
-  assert(!d_terms.empty());
+  assert(!d_idx.empty());
 
-  /* Terms with higher reference count have lower probability to be picked. */
+  /* Start a new epoch every 100 picks. Terms that are still fresh from
+   * previous epochs are then picked based on their weight. */
   if (d_refs_sum % 100 == 25)
   {
-    assert(d_weights.size() == d_refs.size());
-    for (size_t i = 0; i < d_weights.size(); ++i)
-    {
-      d_weights[i] = d_refs_sum - d_refs[i] + 1;
-    }
+    ++d_epoch;
   }
 
-  size_t idx;
   /* No specifc level requested, pick from any level. */
-  if (level == MAX_LEVEL)
-  {
-    idx = rng.pick_weighted(d_weights);
-  }
+  size_t begin = 0, end = d_levels.size();
   /* Pick from specified level only. */
-  else
+  if (level != MAX_LEVEL)
   {
-    size_t begin = get_level_begin(level);
-    size_t end   = get_level_end(level);
-    assert(end - begin > 0);
-    auto it = d_weights.begin();
-    idx     = rng.pick_weighted<size_t>(it + begin, it + end);
-    idx += begin;
-    assert(begin <= idx);
-    assert(idx < end);
+    assert(level < d_levels.size());
+    assert(!d_levels[level].d_terms.empty());
+    begin = level;
+    end   = level + 1;
   }
 
-  Term t     = d_terms[idx];
-  d_refs[idx] += 1;  // increment reference count
-  d_refs_sum += 1;
+  size_t pos;
+  size_t num_fresh = 0;
+  for (size_t i = begin; i < end; ++i)
+  {
+    const Level& l = d_levels[i];
+    num_fresh += l.d_fresh.sum(get_epoch_begin(l), l.d_terms.size());
+  }
 
-  /* d_terms[idx] was freshly added before, now compute new weight. */
-  if (d_weights[idx] == MURXLA_PICK_MAX_WEIGHT)
+  /* Pick fresh terms uniformly. */
+  if (num_fresh > 0)
+  {
+    size_t n = rng.pick<size_t>(0, num_fresh - 1);
+    for (level = begin;; ++level)
+    {
+      const Level& l     = d_levels[level];
+      size_t epoch_begin = get_epoch_begin(l);
+      size_t num         = l.d_fresh.sum(epoch_begin, l.d_terms.size());
+      if (n < num)
+      {
+        n += l.d_fresh.prefix(epoch_begin);
+        break;
+      }
+      n -= num;
+    }
+    /* Find the position of the n-th fresh term. */
+    pos = d_levels[level].d_fresh.find([&n](size_t, size_t sum) {
+      if (sum > n) return false;
+      n -= sum;
+      return true;
+    });
+  }
+  /* Terms with higher reference count have lower probability to be picked. */
+  else
   {
-    d_weights[idx] = d_refs_sum - d_refs[idx] + 1;
+    size_t weight = d_refs_sum + 1;
+    size_t sum    = 0;
+    for (size_t i = begin; i < end; ++i)
+    {
+      const Level& l = d_levels[i];
+      sum += l.d_terms.size() * weight - l.d_refs.total();
+    }
+    size_t n = rng.pick<size_t>(0, sum - 1);
+    for (level = begin;; ++level)
+    {
+      const Level& l = d_levels[level];
+      size_t w       = l.d_terms.size() * weight - l.d_refs.total();
+      if (n < w) break;
+      n -= w;
+    }
+    pos = d_levels[level].d_refs.find([&n, weight](size_t len, size_t sum) {
+      size_t w = len * weight - sum;
+      if (w > n) return false;
+      n -= w;
+      return true;
+    });
   }
 
-  return t;
+  Level& l = d_levels[level];
+  assert(pos < l.d_terms.size());
+  l.d_refs.add(pos, 1);  // increment reference count
+  l.d_fresh.set(pos, 0);
+  d_refs_sum += 1;
+
+  return l.d_terms[pos];
 }
 
 size_t
@@ -122,7 +156,7 @@ TermRefs::size() const
 void
 TermRefs::push()
 {
-  d_levels.push_back(0);
+  d_levels.emplace_back();
 }
 
 void
@@ -130,58 +164,29 @@ TermRefs::pop()
 {
   assert(d_levels.size() > 1);
 
-  /* Find start of current level. */
-  size_t begin = get_level_begin(d_levels.size() - 1);
-
   /* Erase all terms from current level. */
-  std::vector<Term> removed;
-  for (auto it = d_terms.begin() + begin; it != d_terms.end(); ++it)
+  const Level& l = d_levels.back();
+  for (const Term& t : l.d_terms)
   {
-    d_idx.erase(*it);
-    removed.push_back(*it);
+    d_idx.erase(t);
   }
-  d_terms.erase(d_terms.begin() + begin, d_terms.end());
-  d_refs.erase(d_refs.begin() + begin, d_refs.end());
-  d_weights.erase(d_weights.begin() + begin, d_weights.end());
-  assert(d_idx.size() == d_terms.size());
-  assert(d_terms.size() == d_refs.size());
-  assert(d_refs.size() == d_weights.size());
-
+  d_refs_sum -= l.d_refs.total();
   d_levels.pop_back();
-  // TODO: restore d_refs_sum
 }
 
 size_t
 TermRefs::get_num_terms(size_t level) const
 {
   assert(level < d_levels.size());
-  return d_levels[level];
+  return d_levels[level].d_terms.size();
 }
 
 size_t
-TermRefs::get_level_begin(size_t level)
+TermRefs::get_epoch_begin(const Level& level) const
 {
-  assert(level < d_levels.size());
-
-  size_t offset = 0;
-  for (size_t i = 0; i < level; ++i)
-  {
-    offset += d_levels[i];
-  }
-  return offset;
-}
-
-size_t
-TermRefs::get_level_end(size_t level)
-{
-  assert(level < d_levels.size());
-
-  size_t offset = 0;
-  for (size_t i = 0; i <= level; ++i)
-  {
-    offset += d_levels[i];
-  }
-  return offset;
+  /* No terms were added to the level in the current epoch. */
+  if (level.d_epoch != d_epoch) return level.d_terms.size();
+  return level.d_epoch_begin;
 }
 
 /* -------------------------------------------------------------------------- */
@@ -189,6 +194,19 @@ TermRefs::get_level_end(size_t level)
 TermDb::TermDb(SolverManager& smgr, RNGenerator& rng) : d_smgr(smgr), d_rng(rng)
 {
   d_vars.emplace_back();
+  d_level_sort_kinds.push_back(0);
+  d_level_num_terms.push_back(0);
+}
+
+TermDb::SortKindMask
+TermDb::get_sort_kind_mask(const SortKindSet& kinds)
+{
+  SortKindMask res = 0;
+  for (SortKind kind : kinds)
+  {
+    res |= get_sort_kind_mask(kind);
+  }
+  return res;
 }
 
 void
@@ -201,6 +219,9 @@ TermDb::clear()
   d_funs.clear();
   d_vars.clear();
   d_term_levels.clear();
+  d_level_sort_kinds.clear();
+  d_sort_kinds = 0;
+  d_level_num_terms.clear();
 }
 
 void
@@ -208,6 +229,8 @@ TermDb::reset()
 {
   clear();
   d_vars.emplace_back();
+  d_level_sort_kinds.push_back(0);
+  d_level_num_terms.push_back(0);
 }
 
 size_t
@@ -300,6 +323,9 @@ TermDb::add_term(Term& term,
 
       d_terms.emplace(term->get_id(), term);
       d_term_sorts.insert(sort);
+      d_level_sort_kinds[level] |= get_sort_kind_mask(sort_kind);
+      d_sort_kinds |= get_sort_kind_mask(sort_kind);
+      d_level_num_terms[level] += 1;
 
       if (sort_kind == SORT_FUN)
       {
@@ -420,53 +446,21 @@ bool
 TermDb::has_term(SortKind kind) const
 {
   if (kind == SORT_ANY) return has_term();
-  return d_term_db.find(kind) != d_term_db.end();
+  return d_sort_kinds & get_sort_kind_mask(kind);
 }
 
 bool
 TermDb::has_term(SortKind kind, size_t level) const
 {
-  if (d_term_db.empty()) return false;
-  if (kind == SORT_ANY)
-  {
-    for (const auto& p : d_term_db)
-    {
-      for (const auto& pp : p.second)
-      {
-        if (pp.second.get_num_terms(level) > 0)
-        {
-          return true;
-        }
-      }
-    }
-  }
-
-  auto it = d_term_db.find(kind);
-  if (it != d_term_db.end())
-  {
-    for (const auto& p : it->second)
-    {
-      if (p.second.get_num_terms(level) > 0)
-      {
-        return true;
-      }
-    }
-  }
-  return false;
+  assert(level < d_level_sort_kinds.size());
+  if (kind == SORT_ANY) return has_term(level);
+  return d_level_sort_kinds[level] & get_sort_kind_mask(kind);
 }
 
 bool
 TermDb::has_term(const SortKindSet& kinds) const
 {
-  SortKindSet sk;
-  for (const SortKind& k : kinds)
-  {
-    if (d_term_db.find(k) != d_term_db.end())
-    {
-      return true;
-    }
-  }
-  return false;
+  return d_sort_kinds & get_sort_kind_mask(kinds);
 }
 
 bool
@@ -493,16 +487,8 @@ TermDb::has_term(Sort sort, size_t level) const
 bool
 TermDb::has_term(size_t level) const
 {
-  for (const auto& t : d_term_db)
-  {
-    const auto& smap = t.second;
-    for (const auto& s : smap)
-    {
-      if (smap.at(s.first).get_num_terms(level) > 0) return true;
-      ;
-    }
-  }
-  return false;
+  assert(level < d_level_sort_kinds.size());
+  return d_level_sort_kinds[level] != 0;
 }
 
 bool
@@ -624,15 +610,8 @@ TermDb::get_num_terms(SortKind sort_kind, size_t level) const
 size_t
 TermDb::get_num_terms(size_t level) const
 {
-  size_t res = 0;
-  for (const auto& s : d_term_db)
-  {
-    for (const auto& t : s.second)
-    {
-      res += t.second.get_num_terms(level);
-    }
-  }
-  return res;
+  assert(level < d_level_num_terms.size());
+  return d_level_num_terms[level];
 }
 
 size_t
@@ -756,9 +735,7 @@ SortKind
 TermDb::pick_sort_kind() const
 {
   assert(has_term());
-  auto it = d_term_db.begin();
-  std::advance(it, d_rng.pick<size_t>(0, d_term_db.size() - 1));
-  return it->first;
+  return pick_sort_kind_from_mask(d_sort_kinds);
 }
 
 SortKind
@@ -766,52 +743,38 @@ TermDb::pick_sort_kind(size_t level,
                        const SortKindSet& exclude_sort_kinds) const
 {
   assert(has_term());
-
-  std::unordered_set<SortKind> kinds;
-  for (const auto& p : d_term_db)
-  {
-    if (exclude_sort_kinds.find(p.first) == exclude_sort_kinds.end())
-    {
-      for (const auto& pp : p.second)
-      {
-        if (pp.second.get_num_terms(level) > 0)
-        {
-          kinds.insert(p.first);
-          break;
-        }
-      }
-    }
-  }
-  return d_rng.pick_from_set<SortKindSet, SortKind>(kinds);
+  assert(level < d_level_sort_kinds.size());
+  return pick_sort_kind_from_mask(d_level_sort_kinds[level]
+                                  & ~get_sort_kind_mask(exclude_sort_kinds));
 }
 
 SortKind
 TermDb::pick_sort_kind(const SortKindSet& sort_kinds) const
 {
   assert(has_term());
-
-  std::unordered_set<SortKind> kinds;
-  for (const auto& p : d_term_db)
-  {
-    if (sort_kinds.find(p.first) != sort_kinds.end()) kinds.insert(p.first);
-  }
-  return d_rng.pick_from_set<SortKindSet, SortKind>(kinds);
+  return pick_sort_kind_from_mask(d_sort_kinds
+                                  & get_sort_kind_mask(sort_kinds));
 }
 
 SortKind
 TermDb::pick_sort_kind_excluding(const SortKindSet& exclude_sort_kinds) const
 {
   assert(has_term());
+  return pick_sort_kind_from_mask(d_sort_kinds
+                                  & ~get_sort_kind_mask(exclude_sort_kinds));
+}
 
-  std::unordered_set<SortKind> kinds;
-  for (const auto& p : d_term_db)
+SortKind
+TermDb::pick_sort_kind_from_mask(SortKindMask mask) const
+{
+  assert(mask);
+  uint32_t n = d_rng.pick<uint32_t>(0, __builtin_popcount(mask) - 1);
+  /* Clear the n lowest set bits, the lowest remaining bit is the pick. */
+  for (; n > 0; --n)
   {
-    if (exclude_sort_kinds.find(p.first) == exclude_sort_kinds.end())
-    {
-      kinds.insert(p.first);
-    }
+    mask &= mask - 1;
   }
-  return d_rng.pick_from_set<SortKindSet, SortKind>(kinds);
+  return static_cast<SortKind>(__builtin_ctz(mask));
 }
 
 Sort
@@ -888,6 +851,8 @@ void
 TermDb::push(Term& var)
 {
   d_vars.push_back(var);
+  d_level_sort_kinds.push_back(0);
+  d_level_num_terms.push_back(0);
 
   for (auto& p : d_term_db)
   {
@@ -908,6 +873,13 @@ TermDb::pop(const Term& var)
   assert(d_vars[level] == var);
 
   d_vars.pop_back();
+  d_level_sort_kinds.pop_back();
+  d_level_num_terms.pop_back();
+  d_sort_kinds = 0;
+  for (SortKindMask mask : d_level_sort_kinds)
+  {
+    d_sort_kinds |= mask;
+  }
 
   /* Pop current level from d_term_db and cleanup. */
   for (auto it = d_term_db.begin(); it != d_term_db.end();)
@@ -943,6 +915,7 @@ TermDb::pop(const Term& var)
   for (const auto& p : d_term_db)
   {
     assert(!p.second.empty());
+    assert(d_sort_kinds & get_sort_kind_mask(p.first));
     for (const auto& pp : p.second)
     {
       assert(pp.second.size() > 0);
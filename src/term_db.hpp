@@ -13,6 +13,7 @@
 #include <cstddef>
 #include <iterator>
 
+#include "fenwick_tree.hpp"
 #include "solver/solver.hpp"
 
 namespace murxla {
@@ -41,6 +42,8 @@ class TermRefs
   /**
    * Pick random term based on reference counts.
    * Terms with higher reference count have lower probability to be picked.
+   * Terms that were added since the weights were last refreshed (every 100
+   * picks) and not picked since are picked first.
    */
   Term pick(RNGenerator& rng, size_t level = MAX_LEVEL);
   /** Return number of stored terms. */
@@ -90,22 +93,46 @@ class TermRefs
   size_t get_num_terms(size_t level) const;
 
  private:
-  size_t get_level_begin(size_t level);
-  size_t get_level_end(size_t level);
+  /**
+   * The terms of a scope level, with their references indexed by the position
+   * of the term within the level.
+   *
+   * The pick weight of a term is `d_refs_sum - refs + 1`, it is not stored
+   * but derived from the sum of references of a range of terms, which allows
+   * to pick a term of a level in O(log n).
+   */
+  struct Level
+  {
+    /** The terms. */
+    std::vector<Term> d_terms;
+    /** The references of the terms. */
+    FenwickTree<size_t> d_refs;
+    /** 1 if the term was not picked yet, else 0. */
+    FenwickTree<size_t> d_fresh;
+    /**
+     * The position of the first term that was added in epoch d_epoch. Only
+     * the terms added in the current epoch (see TermRefs::d_epoch) are
+     * considered fresh.
+     */
+    size_t d_epoch_begin = 0;
+    /** The epoch of d_epoch_begin. */
+    uint64_t d_epoch = 0;
+  };
+
+  /** Get the position of the first term of the current epoch of `level`. */
+  size_t get_epoch_begin(const Level& level) const;
 
-  /** Map term to term index. */
+  /** Map term to its level. */
   std::unordered_map<Term, size_t> d_idx;
-  /** Maps term index to term. */
-  std::vector<Term> d_terms;
-  /** Maps term index to references. */
-  std::vector<size_t> d_refs;
-  /** Maps term index to pick weight (used by pick()). */
-  std::vector<size_t> d_weights;
-  /** Sum of all references d_refs, used to compute weights in pick(). */
+  /** Sum of all references, used to compute weights in pick(). */
   size_t d_refs_sum = 0;
-
-  /* Maps level to number of corresponding terms. */
-  std::vector<size_t> d_levels;
+  /** The terms per level. */
+  std::vector<Level> d_levels;
+  /**
+   * The current epoch, incremented every 100 picks. Terms that were added in
+   * the current epoch and not picked yet are picked first.
+   */
+  uint64_t d_epoch = 0;
 };
 
 class TermDb
@@ -115,6 +142,19 @@ class TermDb
   using SortSet     = std::unordered_set<Sort>;
   using SortKindSet = std::unordered_set<SortKind>;
   using SortTermMap = std::unordered_map<SortKind, SortMap>;
+  /** A set of sort kinds, bit k is set if sort kind k is in the set. */
+  using SortKindMask = uint32_t;
+
+  static_assert(SORT_ANY < 8 * sizeof(SortKindMask));
+
+  /** Get the sort kind mask representing given sort kind. */
+  static SortKindMask get_sort_kind_mask(SortKind kind)
+  {
+    assert(kind != SORT_ANY);
+    return SortKindMask(1) << kind;
+  }
+  /** Get the sort kind mask representing given set of sort kinds. */
+  static SortKindMask get_sort_kind_mask(const SortKindSet& kinds);
 
   TermDb(SolverManager& smgr, RNGenerator& rng);
 
@@ -171,6 +211,8 @@ class TermDb
 
   /** Returns all term sorts currently in the database. */
   const SortSet get_sorts() const;
+  /** Returns the sort kinds of all terms currently in the database. */
+  SortKindMask get_sort_kinds() const { return d_sort_kinds; }
 
   /** Return true if term database has a value. */
   bool has_value() const;
@@ -345,6 +387,9 @@ class TermDb
   /** Get the number of terms of given sort kind stored in the database. */
   size_t get_num_terms(SortKind sort_kind) const;
 
+  /** Pick a sort kind from given non-empty sort kind mask. */
+  SortKind pick_sort_kind_from_mask(SortKindMask mask) const;
+
   /** Set scope levels for a given term. */
   void set_levels(const Term term, const std::vector<uint64_t>& levels);
 
@@ -390,6 +435,17 @@ class TermDb
 
   /** Sorts currently used in d_term_db. */
   SortSet d_term_sorts;
+
+  /**
+   * Maps scope level to the sort kinds of the terms at that level.
+   * Maintained on add_term, push and pop to answer has_term queries on sort
+   * kinds without walking d_term_db.
+   */
+  std::vector<SortKindMask> d_level_sort_kinds;
+  /** The sort kinds of all terms in d_term_db, the union of all levels. */
+  SortKindMask d_sort_kinds = 0;
+  /** Maps scope level to the number of terms at that level. */
+  std::vector<size_t> d_level_num_terms;
 };
 
 }  // namespace murxla
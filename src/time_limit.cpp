@@ -0,0 +1,41 @@
+/***
+ * Murxla: A Model-Based API Fuzzer for SMT solvers.
+ *
+ * This file is part of Murxla.
+ *
+ * Copyright (C) 2019-2022 by the authors listed in the AUTHORS file.
+ *
+ * See LICENSE for more information on using this software.
+ */
+#include "time_limit.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+namespace murxla {
+
+/* -------------------------------------------------------------------------- */
+
+void
+AdaptiveTimeLimit::add(double time)
+{
+  d_run_times.add(static_cast<uint64_t>(std::max(time, 0.0) * 1000000));
+}
+
+double
+AdaptiveTimeLimit::get(double max_time) const
+{
+  assert(max_time > 0);
+  if (d_run_times.d_count < MIN_SAMPLES)
+  {
+    return max_time;
+  }
+
+  double time =
+      static_cast<double>(d_run_times.percentile(PERCENTILE)) / 1000000;
+  return std::min(std::max(FACTOR * time, MIN_TIME), max_time);
+}
+
+/* -------------------------------------------------------------------------- */
+
+}  // namespace murxla
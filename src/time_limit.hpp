@@ -0,0 +1,70 @@
+/***
+ * Murxla: A Model-Based API Fuzzer for SMT solvers.
+ *
+ * This file is part of Murxla.
+ *
+ * Copyright (C) 2019-2022 by the authors listed in the AUTHORS file.
+ *
+ * See LICENSE for more information on using this software.
+ */
+#ifndef __MURXLA__TIME_LIMIT_H
+#define __MURXLA__TIME_LIMIT_H
+
+#include <cstdint>
+
+#include "statistics.hpp"
+
+namespace murxla {
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * Adaptive time limit for test runs, learned from the distribution of
+ * observed run times.
+ *
+ * Run times are recorded in microseconds in a latency histogram. The time
+ * limit is a multiple of a high percentile of the recorded run times, bounded
+ * by a given maximum time limit. Test runs that are killed due to the time
+ * limit should be recorded with the time limit as their run time, such that
+ * the time limit does not shrink when many test runs time out.
+ */
+class AdaptiveTimeLimit
+{
+ public:
+  /** The number of recorded run times required to adapt the time limit. */
+  static constexpr uint64_t MIN_SAMPLES = 100;
+  /** The percentile of run times the time limit is based on. */
+  static constexpr double PERCENTILE = 0.99;
+  /** The factor applied to the percentile. */
+  static constexpr double FACTOR = 2;
+  /** The minimum time limit in seconds. */
+  static constexpr double MIN_TIME = 0.1;
+
+  /** Record the run time of a test run in seconds. */
+  void add(double time);
+
+  /**
+   * Get the time limit for the next test run.
+   * max_time: The maximum time limit in seconds, must be greater than 0.
+   * Returns `max_time` if not enough run times have been recorded yet.
+   */
+  double get(double max_time) const;
+
+  /** Get the histogram of the recorded run times in microseconds. */
+  const statistics::LatencyHistogram& get_run_times() const
+  {
+    return d_run_times;
+  }
+  /** Get the histogram of the recorded run times for restoring it. */
+  statistics::LatencyHistogram& get_run_times() { return d_run_times; }
+
+ private:
+  /** The recorded run times in microseconds. */
+  statistics::LatencyHistogram d_run_times{};
+};
+
+/* -------------------------------------------------------------------------- */
+
+}  // namespace murxla
+
+#endif
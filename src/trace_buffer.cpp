@@ -0,0 +1,111 @@
+/***
+ * Murxla: A Model-Based API Fuzzer for SMT solvers.
+ *
+ * This file is part of Murxla.
+ *
+ * Copyright (C) 2019-2022 by the authors listed in the AUTHORS file.
+ *
+ * See LICENSE for more information on using this software.
+ */
+#include "trace_buffer.hpp"
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <new>
+
+#include "except.hpp"
+
+#ifndef MAP_NORESERVE
+#define MAP_NORESERVE 0
+#endif
+
+namespace murxla {
+
+/* -------------------------------------------------------------------------- */
+
+TraceBuffer::TraceBuffer(size_t capacity) : d_capacity(capacity)
+{
+  void* m = mmap(nullptr,
+                 sizeof(Header) + d_capacity,
+                 PROT_WRITE | PROT_READ,
+                 MAP_SHARED | MAP_ANONYMOUS | MAP_NORESERVE,
+                 -1,
+                 0);
+  MURXLA_EXIT_ERROR(m == MAP_FAILED) << "failed to allocate trace buffer";
+  d_header = new (m) Header();
+  d_data   = static_cast<char*>(m) + sizeof(Header);
+}
+
+TraceBuffer::~TraceBuffer()
+{
+  d_header->~Header();
+  munmap(d_header, sizeof(Header) + d_capacity);
+}
+
+void
+TraceBuffer::clear()
+{
+  /* Release the pages of a large trace, else they stay resident for the rest
+   * of the campaign. Pages up to RESIDENT_SIZE are kept since they are
+   * rewritten by the next trace anyway. */
+  uint64_t size = d_header->d_size;
+  if (size > RESIDENT_SIZE)
+  {
+    size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    char* base       = reinterpret_cast<char*>(d_header);
+    size_t begin     = sizeof(Header) + RESIDENT_SIZE;
+    size_t end       = sizeof(Header) + size;
+    begin            = (begin + page_size - 1) / page_size * page_size;
+    end              = (end + page_size - 1) / page_size * page_size;
+    /* Failing to release the pages is not an error. */
+    (void) madvise(base + begin, end - begin, MADV_REMOVE);
+  }
+  d_header->d_truncated = false;
+  d_header->d_size      = 0;
+}
+
+bool
+TraceBuffer::is_truncated() const
+{
+  return d_header->d_truncated;
+}
+
+std::string
+TraceBuffer::str() const
+{
+  return std::string(d_data, d_header->d_size);
+}
+
+TraceBuffer::int_type
+TraceBuffer::overflow(int_type c)
+{
+  if (traits_type::eq_int_type(c, traits_type::eof()))
+  {
+    return traits_type::not_eof(c);
+  }
+  char ch = traits_type::to_char_type(c);
+  xsputn(&ch, 1);
+  return c;
+}
+
+std::streamsize
+TraceBuffer::xsputn(const char* s, std::streamsize n)
+{
+  uint64_t size = d_header->d_size.load(std::memory_order_relaxed);
+  if (size + n > d_capacity)
+  {
+    /* Silently drop the remaining trace, the parent replays the test run. */
+    d_header->d_truncated = true;
+    return n;
+  }
+  std::memcpy(d_data + size, s, n);
+  /* Publish the data only after it was written. */
+  d_header->d_size.store(size + n, std::memory_order_release);
+  return n;
+}
+
+/* -------------------------------------------------------------------------- */
+
+}  // namespace murxla
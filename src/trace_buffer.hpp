@@ -0,0 +1,93 @@
+/***
+ * Murxla: A Model-Based API Fuzzer for SMT solvers.
+ *
+ * This file is part of Murxla.
+ *
+ * Copyright (C) 2019-2022 by the authors listed in the AUTHORS file.
+ *
+ * See LICENSE for more information on using this software.
+ */
+#ifndef __MURXLA__TRACE_BUFFER_H
+#define __MURXLA__TRACE_BUFFER_H
+
+#include <atomic>
+#include <cstdint>
+#include <streambuf>
+#include <string>
+
+namespace murxla {
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * Stream buffer for the API trace of a forked test run process in shared
+ * memory.
+ *
+ * The buffer is allocated by the parent process before forking. Every write
+ * of the child process goes directly into shared memory (no intermediate
+ * buffering), and thus the trace up to the point where the child crashed or
+ * aborted is available to the parent without replaying the test run.
+ *
+ * The capacity is reserved as virtual memory only, pages are allocated when
+ * they are written to and released again when a large trace is cleared. If the trace exceeds the capacity, it is truncated
+ * and the parent has to replay the test run to get the full trace.
+ */
+class TraceBuffer : public std::streambuf
+{
+ public:
+  /** The default capacity of the buffer in bytes. */
+  static constexpr size_t DEFAULT_CAPACITY = 64 * 1024 * 1024;
+  /**
+   * The number of bytes of the buffer that stay allocated when the buffer is
+   * cleared, the pages of larger traces are released.
+   */
+  static constexpr size_t RESIDENT_SIZE = 1024 * 1024;
+
+  /**
+   * Constructor.
+   * capacity: The maximum number of bytes of the trace.
+   */
+  TraceBuffer(size_t capacity = DEFAULT_CAPACITY);
+  /** Destructor. */
+  ~TraceBuffer();
+
+  TraceBuffer(const TraceBuffer&) = delete;
+  TraceBuffer& operator=(const TraceBuffer&) = delete;
+
+  /**
+   * Discard the contents of the buffer and release the memory of the trace
+   * beyond RESIDENT_SIZE.
+   */
+  void clear();
+  /** Return true if the trace exceeded the capacity of the buffer. */
+  bool is_truncated() const;
+  /** Get the contents of the buffer. */
+  std::string str() const;
+
+ protected:
+  int_type overflow(int_type c) override;
+  std::streamsize xsputn(const char* s, std::streamsize n) override;
+
+ private:
+  /** The header of the buffer in shared memory. */
+  struct Header
+  {
+    /** The number of bytes written. */
+    std::atomic<uint64_t> d_size;
+    /** True if the trace exceeded the capacity. */
+    std::atomic<bool> d_truncated;
+  };
+
+  /** The header of the shared memory region. */
+  Header* d_header = nullptr;
+  /** The data of the buffer, directly follows the header. */
+  char* d_data = nullptr;
+  /** The capacity of the buffer in bytes. */
+  size_t d_capacity = 0;
+};
+
+/* -------------------------------------------------------------------------- */
+
+}  // namespace murxla
+
+#endif
@@ -0,0 +1,927 @@
+/***
+ * Murxla: A Model-Based API Fuzzer for SMT solvers.
+ *
+ * This file is part of Murxla.
+ *
+ * Copyright (C) 2019-2022 by the authors listed in the AUTHORS file.
+ *
+ * See LICENSE for more information on using this software.
+ */
+#include "trace_mutator.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include "config.hpp"
+#include "solver/solver.hpp"
+#include "util.hpp"
+
+namespace murxla {
+
+/* -------------------------------------------------------------------------- */
+
+namespace {
+
+/** The actions that set up the solver, they are never mutated. */
+const std::unordered_set<Action::Kind> s_setup_kinds = {
+    ActionNew::s_name,
+    ActionSetLogic::s_name,
+    ActionSetOption::s_name,
+    ActionSetOptionReq::s_name,
+};
+
+/** The actions that declare symbols, they are never duplicated. */
+const std::unordered_set<Action::Kind> s_declare_kinds = {
+    ActionMkConst::s_name,
+    ActionMkFun::s_name,
+    ActionMkSort::s_name,
+    ActionMkVar::s_name,
+};
+
+/**
+ * The actions that depend on the result of the previous satisfiability check
+ * and are thus only valid in the original context of the trace. Solver
+ * specific actions (not listed in `s_core_kinds`) are handled the same way.
+ */
+const std::unordered_set<Action::Kind> s_query_kinds = {
+    ActionGetUnsatAssumptions::s_name,
+    ActionGetUnsatCore::s_name,
+    ActionGetValue::s_name,
+    ActionPrintModel::s_name,
+};
+
+/** The actions that require incremental solving to be enabled. */
+const std::unordered_set<Action::Kind> s_incremental_kinds = {
+    ActionCheckSatAssuming::s_name,
+    ActionGetUnsatAssumptions::s_name,
+    ActionPop::s_name,
+    ActionPush::s_name,
+};
+
+/** The actions that are not solver specific. */
+const std::unordered_set<Action::Kind> s_core_kinds = {
+    ActionAssertFormula::s_name,
+    ActionCheckSat::s_name,
+    ActionCheckSatAssuming::s_name,
+    ActionDelete::s_name,
+    ActionGetUnsatAssumptions::s_name,
+    ActionGetUnsatCore::s_name,
+    ActionGetValue::s_name,
+    ActionInstantiateSort::s_name,
+    ActionMkConst::s_name,
+    ActionMkFun::s_name,
+    ActionMkSort::s_name,
+    ActionMkSpecialValue::s_name,
+    ActionMkTerm::s_name,
+    ActionMkValue::s_name,
+    ActionMkVar::s_name,
+    ActionNew::s_name,
+    ActionPop::s_name,
+    ActionPrintModel::s_name,
+    ActionPush::s_name,
+    ActionReset::s_name,
+    ActionResetAssertions::s_name,
+    ActionSetLogic::s_name,
+    ActionSetOption::s_name,
+    ActionSetOptionReq::s_name,
+    ActionTermGetChildren::s_name,
+};
+
+/** The sort kinds without parameters, a sort of such a kind is unique. */
+const std::unordered_set<std::string> s_unique_sort_kinds = {
+    "SORT_BOOL",
+    "SORT_INT",
+    "SORT_REAL",
+    "SORT_REGLAN",
+    "SORT_RM",
+    "SORT_STRING",
+};
+
+/**
+ * The sort kinds of declared sorts. Sorts of these kinds with equal
+ * signatures are still different sorts, their signatures are thus only valid
+ * within the id namespace they were created in (marked with a leading '#').
+ */
+const std::unordered_set<std::string> s_declared_sort_kinds = {
+    "SORT_DT",
+    "SORT_UNINTERPRETED",
+};
+
+/** Return true if given token is a sort or term id. */
+bool
+is_id(const std::string& token)
+{
+  return token.size() > 1 && (token[0] == 's' || token[0] == 't')
+         && std::all_of(token.begin() + 1, token.end(), [](char c) {
+              return c >= '0' && c <= '9';
+            });
+}
+
+/**
+ * Get the variables bound by given statement (with the arguments of the
+ * action in `tokens`), in the order in which their scopes are popped. The
+ * first variable must be the innermost open variable.
+ */
+std::vector<std::string>
+get_bound_vars(const Action::Kind& kind, const std::vector<std::string>& tokens)
+{
+  std::vector<std::string> args, res;
+  for (const std::string& token : tokens)
+  {
+    if (token[0] == 't' && is_id(token)) args.push_back(token);
+  }
+  if (kind == ActionMkTerm::s_name && !tokens.empty() && !args.empty())
+  {
+    const Op::Kind& op = tokens[0];
+    if (op == Op::FORALL || op == Op::EXISTS)
+    {
+      res.assign(args.begin(), args.end() - 1);
+    }
+    else if (op == Op::SET_COMPREHENSION && args.size() > 2)
+    {
+      res.assign(args.begin() + 2, args.end());
+    }
+    else if (op == Op::DT_MATCH_BIND_CASE)
+    {
+      res.assign(args.rbegin() + 1, args.rend());
+    }
+  }
+  else if (kind == ActionMkFun::s_name && !args.empty())
+  {
+    res.assign(args.rbegin() + 1, args.rend());
+  }
+  return res;
+}
+
+/** Get the key of given id in given epoch (or namespace). */
+std::string
+get_key(uint32_t epoch, const std::string& id)
+{
+  return std::to_string(epoch) + ":" + id;
+}
+
+/**
+ * Rename the quoted symbols in given token.
+ * renames: Maps symbols to their new names.
+ * suffix : If not empty, the suffix to append to symbols that are not yet
+ *          renamed (which are then added to `renames`).
+ */
+void
+rename_symbols(std::string& token,
+               std::unordered_map<std::string, std::string>& renames,
+               const std::string& suffix)
+{
+  size_t end = 0;
+  for (size_t begin = token.find('"'); begin != std::string::npos;
+       begin       = token.find('"', end + 1))
+  {
+    end = token.find('"', begin + 1);
+    if (end == std::string::npos) break;
+    std::string symbol = token.substr(begin + 1, end - begin - 1);
+    auto it            = renames.find(symbol);
+    if (it == renames.end())
+    {
+      if (suffix.empty() || symbol.empty()) continue;
+      /* Keep piped symbols quoted. */
+      std::string renamed =
+          symbol.back() == '|'
+              ? symbol.substr(0, symbol.size() - 1) + suffix + "|"
+              : symbol + suffix;
+      it = renames.emplace(symbol, renamed).first;
+    }
+    token.replace(begin + 1, end - begin - 1, it->second);
+    end = begin + it->second.size() + 1;
+  }
+}
+
+}  // namespace
+
+/* -------------------------------------------------------------------------- */
+
+TraceMutator::TraceMutator(const std::string& options_line)
+    : d_options_line(options_line)
+{
+}
+
+size_t
+TraceMutator::add(const std::string& path)
+{
+  std::vector<std::string> file_names;
+  if (std::filesystem::is_directory(path))
+  {
+    for (const auto& entry :
+         std::filesystem::recursive_directory_iterator(path))
+    {
+      if (entry.is_regular_file() && entry.path().extension() == ".trace")
+      {
+        file_names.push_back(entry.path().string());
+      }
+    }
+    /* Independent of the order of the directory entries. */
+    std::sort(file_names.begin(), file_names.end());
+  }
+  else
+  {
+    file_names.push_back(path);
+  }
+
+  size_t res = 0;
+  for (const auto& file_name : file_names)
+  {
+    res += parse(file_name);
+  }
+  return res;
+}
+
+bool
+TraceMutator::parse(const std::string& file_name)
+{
+  std::ifstream file = open_input_file(file_name, false);
+  std::string line, options_line;
+  Trace trace;
+  std::vector<Line>& lines = trace.d_lines;
+
+  while (std::getline(file, line))
+  {
+    if (line.empty() || line[0] == '#') continue;
+    if (line.rfind("set-murxla-options", 0) == 0)
+    {
+      options_line = rstrip(line);
+      continue;
+    }
+    auto [seed, kind, tokens] = tokenize(line);
+    if (kind.empty()) continue;
+    if (kind == "return")
+    {
+      if (lines.empty() || !lines.back().d_returns.empty()) return false;
+      lines.back().d_returns = tokens;
+    }
+    else
+    {
+      Line& l    = lines.emplace_back();
+      l.d_seed   = seed;
+      l.d_kind   = kind;
+      l.d_tokens = tokens;
+    }
+  }
+
+  if (options_line != d_options_line || lines.empty()
+      || lines[0].d_kind != ActionNew::s_name)
+  {
+    return false;
+  }
+  lines.back().d_truncated = lines.back().d_returns.empty();
+
+  uint32_t idx    = static_cast<uint32_t>(d_traces.size());
+  uint32_t epoch  = 0;
+  uint32_t n_sat  = 0;
+  bool is_setup   = true;
+  trace.d_logics.emplace_back();
+  trace.d_incremental.push_back(false);
+
+  for (size_t i = 0, n = lines.size(); i < n; ++i)
+  {
+    Line& l                            = lines[i];
+    const Action::Kind& kind           = l.d_kind;
+    const std::vector<std::string>& ts = l.d_tokens;
+    const std::vector<std::string>& rs = l.d_returns;
+    l.d_trace                          = idx;
+    l.d_epoch                          = epoch;
+
+    if (is_setup && s_setup_kinds.find(kind) == s_setup_kinds.end())
+    {
+      trace.d_body = i;
+      is_setup     = false;
+    }
+
+    if (kind == ActionSetLogic::s_name && !ts.empty())
+    {
+      trace.d_logics[epoch] = ts[0];
+    }
+    if (s_incremental_kinds.find(kind) != s_incremental_kinds.end()
+        || ((kind == ActionCheckSat::s_name
+             || kind == ActionCheckSatAssuming::s_name)
+            && ++n_sat > 1))
+    {
+      trace.d_incremental[epoch] = true;
+    }
+
+    /* Sort signatures. */
+    if ((kind == ActionMkSort::s_name || kind == ActionInstantiateSort::s_name)
+        && rs.size() == 1 && !ts.empty())
+    {
+      std::stringstream sig;
+      bool declared = kind == ActionInstantiateSort::s_name
+                      || s_declared_sort_kinds.find(ts[0])
+                             != s_declared_sort_kinds.end();
+      bool known    = true;
+      if (declared)
+      {
+        sig << "#" << idx << ":" << get_key(epoch, rs[0]);
+      }
+      else
+      {
+        sig << ts[0];
+        for (size_t j = 1; j < ts.size() && known; ++j)
+        {
+          auto it = is_id(ts[j])
+                        ? trace.d_sort_sigs.find(get_key(epoch, ts[j]))
+                        : trace.d_sort_sigs.end();
+          if (!is_id(ts[j]))
+          {
+            sig << " " << ts[j];
+          }
+          else if (it != trace.d_sort_sigs.end() && it->second[0] != '#')
+          {
+            sig << " (" << it->second << ")";
+          }
+          else
+          {
+            known = false;
+          }
+        }
+      }
+      if (known)
+      {
+        trace.d_sort_sigs.emplace(get_key(epoch, rs[0]), sig.str());
+      }
+    }
+    else if (kind == ActionMkTerm::s_name && rs.size() == 2 && ts.size() > 1
+             && s_unique_sort_kinds.find(ts[1]) != s_unique_sort_kinds.end())
+    {
+      trace.d_sort_sigs.emplace(get_key(epoch, rs[1]), ts[1]);
+    }
+
+    /* Term sorts and terms without free variables. */
+    if ((kind == ActionMkConst::s_name || kind == ActionMkValue::s_name
+         || kind == ActionMkSpecialValue::s_name)
+        && rs.size() == 1 && !ts.empty())
+    {
+      trace.d_term_sorts.emplace(get_key(epoch, rs[0]), ts[0]);
+      trace.d_closed_terms.insert(get_key(epoch, rs[0]));
+    }
+    else if (kind == ActionMkTerm::s_name && rs.size() == 2)
+    {
+      trace.d_term_sorts.emplace(get_key(epoch, rs[0]), rs[1]);
+      if (std::all_of(ts.begin(), ts.end(), [&](const std::string& t) {
+            return t[0] != 't' || !is_id(t)
+                   || trace.d_closed_terms.find(get_key(epoch, t))
+                          != trace.d_closed_terms.end();
+          }))
+      {
+        trace.d_closed_terms.insert(get_key(epoch, rs[0]));
+      }
+    }
+
+    if (kind == ActionReset::s_name)
+    {
+      epoch += 1;
+      n_sat = 0;
+      trace.d_logics.emplace_back();
+      trace.d_incremental.push_back(false);
+    }
+  }
+  if (is_setup) return false;
+
+  d_traces.push_back(std::move(trace));
+  return true;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void
+TraceMutator::mutate(RNGenerator& rng,
+                     const Solver& solver,
+                     const SolverOptions& options,
+                     std::ostream& out) const
+{
+  assert(!d_traces.empty());
+  std::vector<Line> lines =
+      d_traces[rng.pick<size_t>(0, d_traces.size() - 1)].d_lines;
+
+  uint32_t num_ns        = 0;
+  uint32_t num_mutations = rng.pick<uint32_t>(1, MURXLA_MAX_N_MUTATIONS);
+  for (uint32_t i = 0, n = 0; n < num_mutations && i < 10 * num_mutations;
+       ++i)
+  {
+    Mutation mutation = static_cast<Mutation>(rng.pick<uint32_t>(DROP, OPTION));
+    n += apply(rng, mutation, options, lines, num_ns);
+  }
+
+  if (!d_options_line.empty())
+  {
+    out << d_options_line << std::endl;
+  }
+  repair(rng, lines, solver.get_option_name_incremental(), out);
+}
+
+bool
+TraceMutator::apply(RNGenerator& rng,
+                    Mutation mutation,
+                    const SolverOptions& options,
+                    std::vector<Line>& lines,
+                    uint32_t& num_ns) const
+{
+  std::vector<size_t> candidates;
+
+  switch (mutation)
+  {
+    case DROP:
+    case DUPLICATE:
+    case SWAP:
+      for (size_t i = 0, n = lines.size(); i < n; ++i)
+      {
+        const Line& l = lines[i];
+        if (s_setup_kinds.find(l.d_kind) != s_setup_kinds.end()
+            || l.d_kind == ActionReset::s_name
+            || l.d_kind == ActionDelete::s_name)
+        {
+          continue;
+        }
+        if (mutation == DUPLICATE
+            && (l.d_truncated
+                || s_declare_kinds.find(l.d_kind) != s_declare_kinds.end()))
+        {
+          continue;
+        }
+        if (mutation == SWAP
+            && std::none_of(
+                l.d_tokens.begin(), l.d_tokens.end(), [](const auto& t) {
+                  return t[0] == 't' && is_id(t);
+                }))
+        {
+          continue;
+        }
+        candidates.push_back(i);
+      }
+      break;
+
+    case SPLICE:
+      for (size_t i = 1, n = lines.size(); i <= n; ++i)
+      {
+        if (s_setup_kinds.find(lines[i - 1].d_kind) == s_setup_kinds.end())
+        {
+          candidates.push_back(i);
+        }
+      }
+      break;
+
+    case OPTION:
+      for (size_t i = 0, n = lines.size(); i < n; ++i)
+      {
+        const Line& l = lines[i];
+        if (l.d_kind == ActionSetOption::s_name && l.d_tokens.size() == 2)
+        {
+          candidates.push_back(i);
+        }
+      }
+      break;
+  }
+
+  if (candidates.empty()) return false;
+  size_t idx = candidates[rng.pick<size_t>(0, candidates.size() - 1)];
+
+  switch (mutation)
+  {
+    case DROP:
+      lines.erase(lines.begin() + idx);
+      if (idx < lines.size()) lines[idx].d_mutated = true;
+      break;
+
+    case DUPLICATE:
+    {
+      /* Insert the copy after the original, but before the next reset. */
+      size_t end = idx + 1;
+      while (end < lines.size() && lines[end].d_kind != ActionReset::s_name
+             && !lines[end].d_truncated)
+      {
+        ++end;
+      }
+      Line copy      = lines[idx];
+      copy.d_mutated = true;
+      lines.insert(lines.begin() + rng.pick<size_t>(idx + 1, end), copy);
+    }
+    break;
+
+    case SWAP: lines[idx].d_swap = true; break;
+
+    case SPLICE:
+    {
+      /* Splice with a suffix of a trace with the same logic. */
+      std::string logic;
+      for (size_t i = idx; i > 0; --i)
+      {
+        if (lines[i - 1].d_kind == ActionSetLogic::s_name
+            && !lines[i - 1].d_tokens.empty())
+        {
+          logic = lines[i - 1].d_tokens[0];
+          break;
+        }
+      }
+      const Trace& trace = d_traces[rng.pick<size_t>(0, d_traces.size() - 1)];
+      size_t pos = rng.pick<size_t>(trace.d_body, trace.d_lines.size() - 1);
+      if (trace.d_logics[trace.d_lines[pos].d_epoch] != logic) return false;
+
+      num_ns += 1;
+      lines.resize(idx);
+      for (size_t i = pos, n = trace.d_lines.size(); i < n; ++i)
+      {
+        Line& l = lines.emplace_back(trace.d_lines[i]);
+        l.d_ns  = num_ns;
+      }
+      lines[idx].d_mutated = true;
+    }
+    break;
+
+    case OPTION:
+    {
+      Line& l          = lines[idx];
+      std::string& val = l.d_tokens[1];
+      auto it          = options.find(l.d_tokens[0]);
+      if (it != options.end())
+      {
+        val = it->second->pick_value(rng);
+      }
+      else if (val == "true" || val == "false")
+      {
+        val = val == "true" ? "false" : "true";
+      }
+      else
+      {
+        return false;
+      }
+      l.d_mutated = true;
+    }
+    break;
+  }
+  return true;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void
+TraceMutator::repair(RNGenerator& rng,
+                     const std::vector<Line>& lines,
+                     const std::string& inc_opt,
+                     std::ostream& out) const
+{
+  /* Maps namespace, epoch and id of the original trace to the new id. */
+  std::unordered_map<std::string, std::string> ids;
+  /* Maps signatures to the new ids of the sorts with this signature. */
+  std::unordered_map<std::string, std::vector<std::string>> sig_sorts;
+  /* Maps the new ids of sorts to their signature. */
+  std::unordered_map<std::string, std::string> sort_sigs;
+  /* Maps the new ids of terms to the new ids of their sorts. */
+  std::unordered_map<std::string, std::string> term_sorts;
+  /* Maps the new ids of sorts to the new ids of closed terms of the sort. */
+  std::unordered_map<std::string, std::vector<std::string>> closed_terms;
+  /* The new ids of all closed terms. */
+  std::unordered_set<std::string> closed_set;
+  /* The new ids of the variables whose scope is open, innermost last. */
+  std::vector<std::string> open_vars;
+  /* Maps the new ids of terms to the variables they contain. */
+  std::unordered_map<std::string, std::vector<std::string>> term_vars;
+  /* Maps namespace to the renamed symbols of the namespace. */
+  std::unordered_map<uint32_t, std::unordered_map<std::string, std::string>>
+      renames;
+  /* The suffix for renamed symbols of spliced in statements. */
+  std::string suffix = "_m" + std::to_string(rng.pick<uint32_t>(0, 0xffff));
+
+  uint64_t n_sorts = 0, n_terms = 0;
+  uint32_t n_push_levels = 0, n_sat_calls = 0;
+  bool incremental = d_traces[lines[0].d_trace].d_incremental[0];
+  bool dirty       = false;
+
+  /* Get the signature (key into 'sig_sorts') of the original sort. */
+  auto get_sig = [&](const Line& l, const std::string& id) -> std::string {
+    const Trace& trace = d_traces[l.d_trace];
+    auto it            = trace.d_sort_sigs.find(get_key(l.d_epoch, id));
+    if (it == trace.d_sort_sigs.end()) return "";
+    /* Declared sorts are only equal within their namespace. */
+    if (it->second[0] == '#') return it->second + "@" + std::to_string(l.d_ns);
+    return it->second;
+  };
+  /* Get the new ids of the closed terms of given (new) sort. */
+  auto get_closed = [&](const std::string& sort) {
+    std::vector<std::string> res;
+    auto it = sort_sigs.find(sort);
+    for (const auto& s : it == sort_sigs.end()
+                             ? std::vector<std::string>{sort}
+                             : sig_sorts.at(it->second))
+    {
+      auto cit = closed_terms.find(s);
+      if (cit == closed_terms.end()) continue;
+      res.insert(res.end(), cit->second.begin(), cit->second.end());
+    }
+    return res;
+  };
+
+  for (size_t i = 0, n = lines.size(); i < n; ++i)
+  {
+    Line l      = lines[i];
+    bool keep   = true;
+    bool closed = true;
+
+    if (l.d_truncated && i + 1 < n) keep = false;
+
+    /* Check if the action is valid in the current context. */
+    if (s_incremental_kinds.find(l.d_kind) != s_incremental_kinds.end()
+        && !incremental)
+    {
+      keep = false;
+    }
+    else if ((l.d_kind == ActionCheckSat::s_name
+              || l.d_kind == ActionCheckSatAssuming::s_name)
+             && !incremental && n_sat_calls > 0)
+    {
+      keep = false;
+    }
+    else if ((s_query_kinds.find(l.d_kind) != s_query_kinds.end()
+              || s_core_kinds.find(l.d_kind) == s_core_kinds.end())
+             && (dirty || l.d_mutated || l.d_swap))
+    {
+      keep = false;
+    }
+    else if (l.d_kind == ActionPop::s_name)
+    {
+      if (l.d_tokens.size() != 1) keep = false;
+      else
+      {
+        uint32_t n_levels = str_to_uint32(l.d_tokens[0]);
+        if (n_levels > n_push_levels)
+        {
+          n_levels     = n_push_levels;
+          l.d_tokens[0] = std::to_string(n_levels);
+          l.d_mutated  = true;
+        }
+        keep = n_levels > 0;
+      }
+    }
+
+    /* Map used ids, substitute ids that are not defined. */
+    for (size_t j = 0, n_tokens = l.d_tokens.size(); keep && j < n_tokens; ++j)
+    {
+      std::string& token = l.d_tokens[j];
+      if (!is_id(token)) continue;
+
+      std::string key = get_key(l.d_ns, get_key(l.d_epoch, token));
+      auto it         = ids.find(key);
+      if (it == ids.end())
+      {
+        std::vector<std::string> candidates;
+        const Trace& trace = d_traces[l.d_trace];
+        if (token[0] == 's')
+        {
+          auto sit = sig_sorts.find(get_sig(l, token));
+          if (sit != sig_sorts.end()) candidates = sit->second;
+        }
+        else if (trace.d_closed_terms.find(get_key(l.d_epoch, token))
+                 != trace.d_closed_terms.end())
+        {
+          auto sit = sig_sorts.find(
+              get_sig(l, trace.d_term_sorts.at(get_key(l.d_epoch, token))));
+          if (sit != sig_sorts.end()) candidates = get_closed(sit->second[0]);
+        }
+        if (candidates.empty())
+        {
+          keep = false;
+          break;
+        }
+        it = ids.emplace(key, candidates[rng.pick<size_t>(
+                                  0, candidates.size() - 1)])
+                 .first;
+        l.d_mutated = true;
+      }
+      token = it->second;
+      if (token[0] == 't' && closed_set.find(token) == closed_set.end())
+      {
+        closed = false;
+      }
+    }
+
+    /* Check that the variables of the arguments are still in scope and that
+     * binders bind the innermost variables. */
+    std::vector<std::string> vars;
+    for (size_t j = 0, n_tokens = l.d_tokens.size(); keep && j < n_tokens; ++j)
+    {
+      const std::string& token = l.d_tokens[j];
+      if (token[0] != 't' || !is_id(token)) continue;
+      auto it = term_vars.find(token);
+      if (it == term_vars.end()) continue;
+      for (const std::string& var : it->second)
+      {
+        if (std::find(open_vars.begin(), open_vars.end(), var)
+            == open_vars.end())
+        {
+          keep = false;
+          break;
+        }
+        if (std::find(vars.begin(), vars.end(), var) == vars.end())
+        {
+          vars.push_back(var);
+        }
+      }
+    }
+    std::vector<std::string> bound_vars;
+    if (keep)
+    {
+      bound_vars = get_bound_vars(l.d_kind, l.d_tokens);
+      for (size_t j = 0, n_vars = bound_vars.size(); j < n_vars; ++j)
+      {
+        if (j >= open_vars.size()
+            || bound_vars[j] != open_vars[open_vars.size() - 1 - j])
+        {
+          keep = false;
+          break;
+        }
+      }
+    }
+
+    if (!keep)
+    {
+      dirty = true;
+      continue;
+    }
+
+    /* Replace a closed term argument with another closed term of the same
+     * sort. */
+    if (l.d_swap)
+    {
+      std::vector<std::pair<size_t, std::vector<std::string>>> swaps;
+      for (size_t j = 0, n_tokens = l.d_tokens.size(); j < n_tokens; ++j)
+      {
+        const std::string& token = l.d_tokens[j];
+        if (token[0] != 't' || closed_set.find(token) == closed_set.end())
+        {
+          continue;
+        }
+        std::vector<std::string> terms = get_closed(term_sorts.at(token));
+        terms.erase(std::remove(terms.begin(), terms.end(), token),
+                    terms.end());
+        if (!terms.empty()) swaps.emplace_back(j, std::move(terms));
+      }
+      if (!swaps.empty())
+      {
+        auto& [j, terms] = swaps[rng.pick<size_t>(0, swaps.size() - 1)];
+        l.d_tokens[j]    = terms[rng.pick<size_t>(0, terms.size() - 1)];
+        l.d_mutated      = true;
+      }
+    }
+
+    /* Rename the symbols of spliced in statements to avoid clashes with the
+     * symbols of the prefix. */
+    if (l.d_ns > 0)
+    {
+      bool declares = s_declare_kinds.find(l.d_kind) != s_declare_kinds.end();
+      auto& ns_renames = renames[l.d_ns];
+      for (size_t j = 0, n_tokens = l.d_tokens.size(); j < n_tokens; ++j)
+      {
+        std::string& token = l.d_tokens[j];
+        if (is_id(token)) continue;
+        if (declares && j == 1 && l.d_kind == ActionMkSort::s_name
+            && l.d_tokens[0] == "SORT_UNINTERPRETED")
+        {
+          token += suffix;
+          continue;
+        }
+        rename_symbols(token, ns_renames, declares ? suffix : "");
+      }
+    }
+
+    /* Map returned ids, create new ids for ids that are not defined. */
+    for (const std::string& id : l.d_returns)
+    {
+      std::string key = get_key(l.d_ns, get_key(l.d_epoch, id));
+      if (ids.find(key) != ids.end()) continue;
+      std::string new_id = id[0] == 's' ? "s" + std::to_string(++n_sorts)
+                                        : "t" + std::to_string(++n_terms);
+      ids.emplace(key, new_id);
+      if (id[0] == 's')
+      {
+        std::string sig = get_sig(l, id);
+        if (!sig.empty())
+        {
+          sort_sigs.emplace(new_id, sig);
+          sig_sorts[sig].push_back(new_id);
+        }
+      }
+    }
+    for (std::string& id : l.d_returns)
+    {
+      id = ids.at(get_key(l.d_ns, get_key(l.d_epoch, id)));
+    }
+
+    /* Update the variable scopes and record the variables of the created
+     * terms. */
+    open_vars.resize(open_vars.size() - bound_vars.size());
+    for (const std::string& var : bound_vars)
+    {
+      vars.erase(std::remove(vars.begin(), vars.end(), var), vars.end());
+    }
+    if (l.d_kind == ActionMkVar::s_name && l.d_returns.size() == 1)
+    {
+      open_vars.push_back(l.d_returns[0]);
+      vars = {l.d_returns[0]};
+    }
+    if (!vars.empty() && !l.d_returns.empty())
+    {
+      term_vars.emplace(l.d_returns[0], vars);
+    }
+
+    /* Record the sorts of the created terms and if they are closed. */
+    if (l.d_returns.size() == 1 && !l.d_tokens.empty()
+        && (l.d_kind == ActionMkConst::s_name || l.d_kind == ActionMkValue::s_name
+            || l.d_kind == ActionMkSpecialValue::s_name
+            || l.d_kind == ActionMkVar::s_name))
+    {
+      const std::string& term = l.d_returns[0];
+      const std::string& sort = l.d_tokens[0];
+      if (term_sorts.emplace(term, sort).second
+          && l.d_kind != ActionMkVar::s_name)
+      {
+        closed_terms[sort].push_back(term);
+        closed_set.insert(term);
+      }
+    }
+    else if (l.d_returns.size() == 2
+             && (l.d_kind == ActionMkTerm::s_name
+                 || l.d_kind == ActionMkFun::s_name))
+    {
+      const std::string& term = l.d_returns[0];
+      const std::string& sort = l.d_returns[1];
+      if (term_sorts.emplace(term, sort).second
+          && l.d_kind == ActionMkTerm::s_name && closed)
+      {
+        closed_terms[sort].push_back(term);
+        closed_set.insert(term);
+      }
+    }
+
+    /* Update the context. */
+    if (l.d_kind == ActionReset::s_name)
+    {
+      ids.clear();
+      sig_sorts.clear();
+      sort_sigs.clear();
+      term_sorts.clear();
+      closed_terms.clear();
+      closed_set.clear();
+      open_vars.clear();
+      term_vars.clear();
+      incremental   = false;
+      n_push_levels = 0;
+      n_sat_calls   = 0;
+      dirty         = false;
+    }
+    else
+    {
+      dirty = dirty || l.d_mutated;
+    }
+    if (l.d_kind == ActionSetOption::s_name && l.d_tokens.size() == 2
+        && l.d_tokens[0] == inc_opt)
+    {
+      incremental = l.d_tokens[1] == "true";
+    }
+    else if (l.d_kind == ActionPush::s_name && l.d_tokens.size() == 1)
+    {
+      n_push_levels += str_to_uint32(l.d_tokens[0]);
+    }
+    else if (l.d_kind == ActionPop::s_name)
+    {
+      n_push_levels -= str_to_uint32(l.d_tokens[0]);
+    }
+    else if (l.d_kind == ActionResetAssertions::s_name)
+    {
+      n_push_levels = 0;
+    }
+    else if (l.d_kind == ActionCheckSat::s_name
+             || l.d_kind == ActionCheckSatAssuming::s_name)
+    {
+      n_sat_calls += 1;
+    }
+
+    out << std::setw(5) << l.d_seed << " " << l.d_kind;
+    for (const std::string& token : l.d_tokens)
+    {
+      out << " " << token;
+    }
+    out << std::endl;
+    if (!l.d_returns.empty())
+    {
+      out << "      return";
+      for (const std::string& id : l.d_returns)
+      {
+        out << " " << id;
+      }
+      out << std::endl;
+    }
+  }
+}
+
+/* -------------------------------------------------------------------------- */
+
+}  // namespace murxla
@@ -0,0 +1,181 @@
+/***
+ * Murxla: A Model-Based API Fuzzer for SMT solvers.
+ *
+ * This file is part of Murxla.
+ *
+ * Copyright (C) 2019-2022 by the authors listed in the AUTHORS file.
+ *
+ * See LICENSE for more information on using this software.
+ */
+#ifndef __MURXLA__TRACE_MUTATOR_H
+#define __MURXLA__TRACE_MUTATOR_H
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "action.hpp"
+#include "rng.hpp"
+#include "solver_option.hpp"
+
+namespace murxla {
+
+/* -------------------------------------------------------------------------- */
+
+class Solver;
+
+/**
+ * Mutation of a corpus of recorded API traces.
+ *
+ * A mutated trace is derived from a trace of the corpus by applying a random
+ * number of structural mutations:
+ * - drop an action
+ * - duplicate an action (that does not declare a symbol)
+ * - replace a term argument of an action with another term of the same sort
+ * - splice a prefix of the trace with a suffix of another trace of the corpus
+ *   (with the same logic)
+ * - re-pick the value of a solver option
+ *
+ * Mutated traces are repaired before they are written out, i.e., all sort and
+ * term ids are renumbered, actions that refer to ids that are not created by
+ * the mutated trace are dropped (or the ids are substituted with ids of the
+ * same sort), and actions that are not valid in the mutated context (e.g.,
+ * pop beyond the current push level, or model queries after a mutation) are
+ * dropped or adjusted. The result can thus be replayed via FSM::untrace().
+ */
+class TraceMutator
+{
+ public:
+  /**
+   * Constructor.
+   * options_line: The `set-murxla-options` line of the current configuration,
+   *               only traces recorded with this configuration are added.
+   */
+  TraceMutator(const std::string& options_line);
+
+  /**
+   * Add the trace with given file name to the corpus, or all traces (files
+   * with suffix `.trace`) in given directory and its subdirectories.
+   * Returns the number of added traces.
+   */
+  size_t add(const std::string& path);
+
+  /** Get the number of traces in the corpus. */
+  size_t size() const { return d_traces.size(); }
+
+  /**
+   * Pick a trace from the corpus, mutate and repair it and write the result
+   * to given output stream.
+   * rng    : The random number generator.
+   * solver : The solver under test, used to query the names of the options
+   *          that enable incremental solving.
+   * options: The configured solver options, used to re-pick option values.
+   * out    : The output stream to write the mutated trace to.
+   */
+  void mutate(RNGenerator& rng,
+              const Solver& solver,
+              const SolverOptions& options,
+              std::ostream& out) const;
+
+ private:
+  /** The kinds of mutations. */
+  enum Mutation
+  {
+    DROP,
+    DUPLICATE,
+    SWAP,
+    SPLICE,
+    OPTION,
+  };
+
+  /** A trace statement with its return statement (if any). */
+  struct Line
+  {
+    /** The solver seed of the statement. */
+    uint32_t d_seed = 0;
+    /** The action kind. */
+    Action::Kind d_kind;
+    /** The arguments of the action. */
+    std::vector<std::string> d_tokens;
+    /** The arguments of the return statement. */
+    std::vector<std::string> d_returns;
+    /**
+     * True if this is the last statement of a trace and it has no return
+     * statement, e.g., if the solver terminated while executing the action.
+     * Such a statement can only be kept as the last statement.
+     */
+    bool d_truncated = false;
+    /** The index of the trace in the corpus this statement stems from. */
+    uint32_t d_trace = 0;
+    /** The number of `reset` statements before this statement. */
+    uint32_t d_epoch = 0;
+    /**
+     * The id namespace of this statement. Statements that were spliced in
+     * get a new namespace to keep their ids apart from the prefix ids.
+     */
+    uint32_t d_ns = 0;
+    /** True if this statement was changed or inserted by a mutation. */
+    bool d_mutated = false;
+    /** True to replace one of its term arguments while repairing. */
+    bool d_swap = false;
+  };
+
+  /** A trace of the corpus. */
+  struct Trace
+  {
+    /** The statements. */
+    std::vector<Line> d_lines;
+    /** The index of the first statement after the setup statements. */
+    size_t d_body = 0;
+    /** The logic per epoch. */
+    std::vector<std::string> d_logics;
+    /** True if the epoch requires incremental solving, per epoch. */
+    std::vector<bool> d_incremental;
+    /**
+     * The signature of each sort, keyed by epoch and sort id. Sorts with
+     * equal signatures are equal. Sorts with unknown structure (e.g.,
+     * sorts of terms that were not created via mk-sort) have no signature.
+     */
+    std::unordered_map<std::string, std::string> d_sort_sigs;
+    /** The sort of each term, keyed by epoch and term id. */
+    std::unordered_map<std::string, std::string> d_term_sorts;
+    /** The terms without free variables, keyed by epoch and term id. */
+    std::unordered_set<std::string> d_closed_terms;
+  };
+
+  /** Parse given trace file, returns false if it is not added. */
+  bool parse(const std::string& file_name);
+
+  /**
+   * Apply a mutation of given kind to the given statements.
+   * Returns false if the mutation is not applicable.
+   */
+  bool apply(RNGenerator& rng,
+             Mutation mutation,
+             const SolverOptions& options,
+             std::vector<Line>& lines,
+             uint32_t& num_ns) const;
+
+  /**
+   * Repair given statements and write them to given output stream.
+   * inc_opt: The name of the option that enables incremental solving.
+   */
+  void repair(RNGenerator& rng,
+              const std::vector<Line>& lines,
+              const std::string& inc_opt,
+              std::ostream& out) const;
+
+  /** The `set-murxla-options` line of the current configuration. */
+  std::string d_options_line;
+  /** The corpus. */
+  std::vector<Trace> d_traces;
+};
+
+/* -------------------------------------------------------------------------- */
+
+}  // namespace murxla
+
+#endif
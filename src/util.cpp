@@ -9,8 +9,13 @@
  */
 #include "util.hpp"
 
+#include <fcntl.h>
+#include <sys/stat.h>
 #include <sys/time.h>
 #include <unistd.h>
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
 
 #include <algorithm>
 #include <cassert>
@@ -424,6 +429,106 @@ Terminal::code(const std::string color) const
 
 /* -------------------------------------------------------------------------- */
 
+OutputCapture::OutputCapture(const std::string& directory)
+{
+  d_fd_out = create("run.out", directory);
+  d_fd_err = create("run.err", directory);
+}
+
+OutputCapture::~OutputCapture()
+{
+  close(d_fd_out);
+  close(d_fd_err);
+}
+
+void
+OutputCapture::redirect() const
+{
+  MURXLA_EXIT_ERROR_FORK(dup2(d_fd_out, STDOUT_FILENO) < 0
+                             || dup2(d_fd_err, STDERR_FILENO) < 0,
+                         true)
+      << "unable to redirect output of test run";
+}
+
+void
+OutputCapture::clear(bool is_forked) const
+{
+  /* The file offsets are shared with the (forked) processes writing to the
+   * capture files and must be reset, too. */
+  MURXLA_EXIT_ERROR_FORK(ftruncate(d_fd_out, 0) != 0
+                             || ftruncate(d_fd_err, 0) != 0
+                             || lseek(d_fd_out, 0, SEEK_SET) < 0
+                             || lseek(d_fd_err, 0, SEEK_SET) < 0,
+                         is_forked)
+      << "unable to clear output of test run";
+}
+
+std::string
+OutputCapture::out() const
+{
+  return read(d_fd_out);
+}
+
+std::string
+OutputCapture::err() const
+{
+  return read(d_fd_err);
+}
+
+void
+OutputCapture::write(const std::string& file_out,
+                     const std::string& file_err) const
+{
+  if (file_out != DEVNULL)
+  {
+    std::ofstream out = open_output_file(file_out, false);
+    out << read(d_fd_out);
+  }
+  if (file_err != DEVNULL)
+  {
+    std::ofstream err = open_output_file(file_err, false);
+    err << read(d_fd_err);
+  }
+}
+
+int32_t
+OutputCapture::create(const std::string& name, const std::string& directory)
+{
+  int32_t fd = -1;
+#if defined(__linux__) && defined(MFD_CLOEXEC)
+  fd = memfd_create(name.c_str(), MFD_CLOEXEC);
+#endif
+  if (fd < 0)
+  {
+    std::string file_name = get_tmp_file_path(name, directory);
+
+    fd = open(file_name.c_str(),
+              O_CREAT | O_RDWR | O_TRUNC | O_CLOEXEC,
+              S_IRUSR | S_IWUSR);
+    MURXLA_EXIT_ERROR(fd < 0) << "unable to open file " << file_name;
+    unlink(file_name.c_str());
+  }
+  return fd;
+}
+
+std::string
+OutputCapture::read(int32_t fd)
+{
+  std::string res;
+  char buf[4096];
+  off_t offset = 0;
+  ssize_t n;
+  while ((n = pread(fd, buf, sizeof(buf), offset)) > 0)
+  {
+    res.append(buf, n);
+    offset += n;
+  }
+  MURXLA_EXIT_ERROR(n < 0) << "unable to read output of test run";
+  return res;
+}
+
+/* -------------------------------------------------------------------------- */
+
 std::string
 get_tmp_file_path(const std::string& filename, const std::string& directory)
 {
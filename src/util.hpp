@@ -96,6 +96,65 @@ class Terminal
 
 /* -------------------------------------------------------------------------- */
 
+/**
+ * Capture of the stdout and stderr output of forked test run processes.
+ *
+ * The output is captured in anonymous in-memory files (memfd) and only
+ * written to disk on demand. If in-memory files are not supported, unlinked
+ * temp files in the given directory are used instead. The capture files are
+ * reused for consecutive test runs.
+ */
+class OutputCapture
+{
+ public:
+  /**
+   * Constructor.
+   * directory: The directory for temp files if in-memory files are not
+   *            supported.
+   */
+  OutputCapture(const std::string& directory);
+  /** Destructor. */
+  ~OutputCapture();
+
+  OutputCapture(const OutputCapture&) = delete;
+  OutputCapture& operator=(const OutputCapture&) = delete;
+
+  /**
+   * Redirect stdout and stderr of the current process into the capture files.
+   * This is called in a forked test run process.
+   */
+  void redirect() const;
+  /**
+   * Discard all captured output.
+   * is_forked: True if called from a forked test run process.
+   */
+  void clear(bool is_forked = false) const;
+
+  /** Get the captured stdout output. */
+  std::string out() const;
+  /** Get the captured stderr output. */
+  std::string err() const;
+
+  /**
+   * Write the captured output to the given files.
+   * Nothing is written for files that are DEVNULL.
+   */
+  void write(const std::string& file_out, const std::string& file_err) const;
+
+ private:
+  /** Create a capture file with given name, return its file descriptor. */
+  static int32_t create(const std::string& name, const std::string& directory);
+  /** Read the contents of capture file with given file descriptor. */
+  static std::string read(int32_t fd);
+
+  /** The file descriptor of the stdout capture file. */
+  int32_t d_fd_out = -1;
+  /** The file descriptor of the stderr capture file. */
+  int32_t d_fd_err = -1;
+};
+
+/* -------------------------------------------------------------------------- */
+
 std::string get_tmp_file_path(const std::string& filename,
                               const std::string& directory);
 
@@ -0,0 +1,81 @@
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "coverage.hpp"
+#include "gtest/gtest.h"
+
+using namespace murxla;
+
+extern "C" void __sanitizer_cov_trace_pc_guard(uint32_t* guard);
+
+namespace {
+
+/** Record the edges with guard indices [begin, end). */
+void
+cover(uint32_t begin, uint32_t end)
+{
+  for (uint32_t guard = begin; guard < end; ++guard)
+  {
+    __sanitizer_cov_trace_pc_guard(&guard);
+  }
+}
+
+}  // namespace
+
+TEST(coverage, merge)
+{
+  CoverageMap map(1, 2);
+  map.start_run(0, 0).d_new_edges = 0;
+  cover(1, 101);
+  ASSERT_EQ(map.merge(0), 100u);
+  map.start_run(0, 1);
+  cover(51, 151);
+  ASSERT_EQ(map.merge(0), 50u);
+  ASSERT_EQ(map.get_num_edges(), 150u);
+}
+
+TEST(coverage, merge_concurrent)
+{
+  /* Workers that cover the same edges concurrently count each edge once. */
+  const size_t num_workers = 8;
+  const uint32_t num_edges = CoverageMap::MAP_SIZE - 1;
+  CoverageMap map(num_workers, 1);
+  std::vector<pid_t> pids;
+  /* The workers start merging when the write end of the pipe is closed. */
+  int32_t start[2];
+  ASSERT_EQ(pipe(start), 0);
+  for (size_t i = 0; i < num_workers; ++i)
+  {
+    pid_t pid = fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0)
+    {
+      close(start[1]);
+      auto& info = map.start_run(i, 0);
+      cover(1, num_edges + 1);
+      char c;
+      (void) read(start[0], &c, 1);
+      info.d_new_edges = map.merge(i);
+      _exit(0);
+    }
+    pids.push_back(pid);
+  }
+  close(start[0]);
+  close(start[1]);
+  for (pid_t pid : pids)
+  {
+    int32_t status;
+    ASSERT_EQ(waitpid(pid, &status, 0), pid);
+    ASSERT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+  }
+  uint64_t new_edges = 0;
+  for (size_t i = 0; i < num_workers; ++i)
+  {
+    new_edges += map.get_run_info(i, 0).d_new_edges;
+  }
+  ASSERT_EQ(new_edges, num_edges);
+  ASSERT_EQ(map.get_num_edges(), num_edges);
+}
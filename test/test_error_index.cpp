@@ -0,0 +1,120 @@
+#include <string>
+
+#include "error_index.hpp"
+#include "gtest/gtest.h"
+
+using namespace murxla;
+
+TEST(error_index, identical)
+{
+  ErrorIndex index;
+  ASSERT_EQ(index.add("error: invalid argument"), 0u);
+  ASSERT_EQ(index.add("segmentation fault"), 1u);
+  ASSERT_EQ(index.size(), 2u);
+  ASSERT_EQ(index.find("error: invalid argument"), 0u);
+  ASSERT_EQ(index.find("segmentation fault"), 1u);
+  ASSERT_EQ(index.get(1), "segmentation fault");
+}
+
+TEST(error_index, empty)
+{
+  ErrorIndex index;
+  ASSERT_EQ(index.find(""), std::nullopt);
+  index.add("");
+  /* Empty messages are never similar. */
+  ASSERT_EQ(index.find(""), std::nullopt);
+  ASSERT_EQ(index.find("error"), std::nullopt);
+}
+
+TEST(error_index, same_group)
+{
+  ErrorIndex index;
+  index.add("murxla: ERROR: solver.cpp:123: assertion 'x != nullptr' failed");
+  /* Whitespace is ignored. */
+  ASSERT_EQ(
+      index.find("murxla: ERROR: solver.cpp:123: assertion 'x != nullptr'  "
+                 "failed\n"),
+      0u);
+  /* Numbers are ignored. */
+  index.add("murxla: ERROR: solver.cpp line 123: assertion failed");
+  ASSERT_EQ(
+      index.find("murxla: ERROR: solver.cpp line 4567: assertion failed"),
+      1u);
+  /* A small difference relative to the length of the message. */
+  ASSERT_EQ(
+      index.find("murxla: ERROR: solver.cpp:123: assertion 'y != nullptr' "
+                 "failed"),
+      0u);
+  /* One additional token. */
+  ASSERT_EQ(
+      index.find("murxla: ERROR: solver.cpp:123: assertion 'x != nullptr' "
+                 "failed x"),
+      0u);
+}
+
+TEST(error_index, different_group)
+{
+  ErrorIndex index;
+  index.add("murxla: ERROR: solver.cpp:123: assertion 'x != nullptr' failed");
+  ASSERT_EQ(index.find("terminate called after throwing an instance of "
+                       "'std::out_of_range'"),
+            std::nullopt);
+  ASSERT_EQ(
+      index.find("murxla: ERROR: parser.cpp:123: assertion 'x != nullptr' "
+                 "failed"),
+      std::nullopt);
+  ASSERT_EQ(index.find("murxla: ERROR:"), std::nullopt);
+
+  ASSERT_EQ(index.add("terminate called after throwing an instance of "
+                      "'std::out_of_range'"),
+            1u);
+  ASSERT_EQ(index.find("terminate called after throwing an instance of "
+                       "'std::out_of_range' "),
+            1u);
+}
+
+TEST(error_index, length_boundary)
+{
+  /* 100 characters, the difference of similar errors is at most 5. */
+  std::string err(95, 'a');
+  err += " bbbb";
+  ASSERT_EQ(err.size(), 100u);
+
+  ErrorIndex index;
+  index.add(err);
+  /* Differing tokens with 4 and 5 non-digit characters. */
+  ASSERT_EQ(index.find(std::string(95, 'a') + " cccc"), 0u);
+  ASSERT_EQ(index.find(std::string(95, 'a') + " ccccc"), 0u);
+  ASSERT_EQ(index.find(std::string(95, 'a') + " cccccc"), std::nullopt);
+  /* Digits do not count. */
+  ASSERT_EQ(index.find(std::string(95, 'a') + " 12345678"), 0u);
+  /* 5 and 6 additional tokens. */
+  ASSERT_EQ(index.find(err + " x x x x x"), 0u);
+  ASSERT_EQ(index.find(err + " x x x x x x"), std::nullopt);
+}
+
+TEST(error_index, length_buckets)
+{
+  /* A short error is similar to a long error with additional tokens. */
+  std::string longer(200, 'a');
+  std::string shorter = "a b";
+  ErrorIndex index;
+  index.add(shorter + " " + longer);
+  ASSERT_EQ(index.find(shorter), 0u);
+
+  /* Errors of different length buckets do not affect each other. */
+  std::string other = "xxxxxxxxxx yyyyyyyyyy zzzzzzzzzz";
+  index.add(other);
+  ASSERT_EQ(index.find("xxxxxxxxxx yyyyyyyyyy wwwwwwwwww"), std::nullopt);
+  ASSERT_EQ(index.find(other + " "), 1u);
+  ASSERT_EQ(index.find(shorter + " " + longer + " c"), 0u);
+
+  /* Many tokens apart relative to the short error, but within the tolerance
+   * of the long error. */
+  std::string many;
+  for (size_t i = 0; i < 10; ++i)
+  {
+    many += " t";
+  }
+  ASSERT_EQ(index.find(shorter + " " + longer + many), 0u);
+}
@@ -0,0 +1,104 @@
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "fenwick_tree.hpp"
+#include "gtest/gtest.h"
+
+using namespace murxla;
+
+TEST(fenwick_tree, prefix)
+{
+  FenwickTree<uint64_t> tree;
+  std::vector<uint64_t> values;
+  std::mt19937 rng(42);
+
+  for (uint64_t i = 0; i < 100; ++i)
+  {
+    uint64_t value = rng() % 10;
+    tree.push_back(value);
+    values.push_back(value);
+
+    uint64_t sum = 0;
+    for (size_t j = 0; j <= values.size(); ++j)
+    {
+      ASSERT_EQ(tree.prefix(j), sum);
+      if (j < values.size()) sum += values[j];
+    }
+  }
+  ASSERT_EQ(tree.size(), 100u);
+
+  for (size_t i = 0; i < 100; ++i)
+  {
+    size_t idx = rng() % values.size();
+    uint64_t value = rng() % 10;
+    tree.set(idx, value);
+    values[idx] = value;
+    ASSERT_EQ(tree.get(idx), value);
+  }
+
+  while (!values.empty())
+  {
+    uint64_t sum = 0;
+    for (size_t j = 0; j < values.size(); ++j)
+    {
+      sum += values[j];
+      ASSERT_EQ(tree.sum(0, j + 1), sum);
+    }
+    ASSERT_EQ(tree.total(), sum);
+    tree.pop_back();
+    values.pop_back();
+    /* Values appended after removal must be consistent. */
+    if (values.size() % 3 == 0 && values.size() > 0)
+    {
+      tree.push_back(1);
+      values.push_back(1);
+      tree.pop_back();
+      values.pop_back();
+    }
+  }
+  ASSERT_TRUE(tree.empty());
+}
+
+TEST(fenwick_tree, find)
+{
+  FenwickTree<uint64_t> tree;
+  std::vector<uint64_t> values = {3, 0, 1, 4, 1, 5, 9, 2, 6};
+  for (uint64_t v : values)
+  {
+    tree.push_back(v);
+  }
+
+  /* The index of the value that contains position n of the sum. */
+  for (uint64_t n = 0, idx = 0, end = values[0]; n < tree.total(); ++n)
+  {
+    while (n >= end) end += values[++idx];
+    uint64_t target = n;
+    size_t pos      = tree.find([&target](size_t, uint64_t sum) {
+      if (sum > target) return false;
+      target -= sum;
+      return true;
+    });
+    ASSERT_EQ(pos, idx);
+  }
+
+  /* Implicit weights 10 - value. */
+  uint64_t weight = 10;
+  std::vector<size_t> counts(values.size());
+  for (uint64_t n = 0; n < values.size() * weight - tree.total(); ++n)
+  {
+    uint64_t target = n;
+    size_t pos      = tree.find([&target, weight](size_t len, uint64_t sum) {
+      uint64_t w = len * weight - sum;
+      if (w > target) return false;
+      target -= w;
+      return true;
+    });
+    ASSERT_LT(pos, values.size());
+    counts[pos] += 1;
+  }
+  for (size_t i = 0; i < values.size(); ++i)
+  {
+    ASSERT_EQ(counts[i], weight - values[i]);
+  }
+}
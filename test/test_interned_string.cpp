@@ -0,0 +1,60 @@
+#include <sstream>
+#include <string>
+#include <unordered_map>
+
+#include "gtest/gtest.h"
+#include "interned_string.hpp"
+
+using namespace murxla;
+
+struct TestTag;
+struct OtherTag;
+
+using TestString = InternedString<TestTag>;
+
+TEST(interned_string, ids)
+{
+  TestString empty;
+  ASSERT_EQ(empty.get_id(), 0u);
+  ASSERT_TRUE(empty.empty());
+  ASSERT_EQ(TestString("").get_id(), 0u);
+
+  TestString a("a");
+  TestString b(std::string("b"));
+  ASSERT_EQ(a.get_id(), 1u);
+  ASSERT_EQ(b.get_id(), 2u);
+  ASSERT_EQ(TestString("a").get_id(), a.get_id());
+  ASSERT_EQ(TestString::get_num_ids(), 3u);
+  ASSERT_EQ(TestString::get_string(b.get_id()), "b");
+
+  /* Ids are assigned separately per tag. */
+  ASSERT_EQ(InternedString<OtherTag>("b").get_id(), 1u);
+}
+
+TEST(interned_string, string)
+{
+  TestString kind("OP_KIND");
+  const std::string& str = kind;
+  ASSERT_EQ(str, "OP_KIND");
+  ASSERT_EQ(kind.size(), 7u);
+  ASSERT_STREQ(kind.c_str(), "OP_KIND");
+
+  std::stringstream ss;
+  ss << kind;
+  ASSERT_EQ(ss.str(), "OP_KIND");
+}
+
+TEST(interned_string, compare)
+{
+  TestString a("x");
+  TestString b("y");
+  ASSERT_TRUE(a == TestString("x"));
+  ASSERT_TRUE(a == "x");
+  ASSERT_TRUE(std::string("x") == a);
+  ASSERT_TRUE(a != b);
+  ASSERT_TRUE(a < b);
+
+  std::unordered_map<TestString, int> map{{a, 1}, {"y", 2}};
+  ASSERT_EQ(map.at("x"), 1);
+  ASSERT_EQ(map.at(b), 2);
+}
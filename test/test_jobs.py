@@ -0,0 +1,86 @@
+#!/usr/bin/env python3
+###
+# Murxla: A Model-Based API Fuzzer for SMT solvers.
+#
+# This file is part of Murxla.
+#
+# Copyright (C) 2019-2022 by the authors listed in the AUTHORS file.
+#
+# See LICENSE for more information on using this software.
+##
+
+# Check that in continuous mode with parallel persistent workers and a short
+# time limit every given seed is reported exactly once, in particular if
+# worker processes are killed on timeout.
+
+import argparse
+import collections
+import importlib.util
+import os
+import subprocess
+import sys
+import tempfile
+
+
+def load_bench():
+    """Load the throughput benchmark script to reuse its fixed seed set."""
+    path = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..',
+                        'scripts', 'murxla-bench.py')
+    spec = importlib.util.spec_from_file_location('murxla_bench', path)
+    module = importlib.util.module_from_spec(spec)
+    spec.loader.exec_module(module)
+    return module
+
+
+def main():
+    ap = argparse.ArgumentParser()
+    ap.add_argument('--murxla', required=True, help='murxla binary')
+    ap.add_argument('--seeds', type=int, default=300, help='number of seeds')
+    ap.add_argument('--jobs', type=int, default=4)
+    ap.add_argument('--persistent', type=int, default=10)
+    ap.add_argument('--time', type=float, default=0.01)
+    args = ap.parse_args()
+
+    with tempfile.TemporaryDirectory() as tmp_dir:
+        seeds_file = os.path.join(tmp_dir, 'seeds.txt')
+        seeds = load_bench().write_seeds(seeds_file, args.seeds)
+        cmd = [
+            args.murxla, '--smt2', '--seeds', seeds_file, '-j',
+            str(args.jobs), '--persistent',
+            str(args.persistent), '-t',
+            str(args.time), '-O', tmp_dir, '-T', tmp_dir
+        ]
+        proc = subprocess.run(cmd,
+                              stdout=subprocess.PIPE,
+                              stderr=subprocess.DEVNULL,
+                              cwd=tmp_dir,
+                              timeout=600,
+                              check=False)
+
+    # Status lines start with the seed (hex) of the reported test run.
+    reported = collections.Counter()
+    for line in proc.stdout.decode(errors='replace').splitlines():
+        cols = line.split()
+        if len(cols) < 2 or not cols[1].isdigit():
+            continue
+        try:
+            reported[int(cols[0], 16)] += 1
+        except ValueError:
+            pass
+
+    ok = True
+    for seed in seeds:
+        if reported[seed] != 1:
+            print(f'seed {seed:x} reported {reported[seed]} times')
+            ok = False
+    for seed in set(reported) - set(seeds):
+        print(f'unexpected seed {seed:x} reported')
+        ok = False
+    if proc.returncode != 0:
+        print(f'murxla exited with {proc.returncode}')
+        ok = False
+    return 0 if ok else 1
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,107 @@
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdlib>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "stats_stream.hpp"
+
+using namespace murxla;
+
+namespace {
+
+/** Create a FIFO in a fresh temp directory. */
+std::string
+make_fifo()
+{
+  char dir[] = "/tmp/murxla-test-XXXXXX";
+  EXPECT_NE(mkdtemp(dir), nullptr);
+  std::string path = std::string(dir) + "/stats.fifo";
+  EXPECT_EQ(mkfifo(path.c_str(), 0600), 0);
+  return path;
+}
+
+/** Remove FIFO created via make_fifo() and its temp directory. */
+void
+remove_fifo(const std::string& path)
+{
+  unlink(path.c_str());
+  rmdir(path.substr(0, path.rfind('/')).c_str());
+}
+
+/** Read what is currently available from given file descriptor. */
+std::string
+read_available(int32_t fd)
+{
+  std::string res;
+  char buf[256];
+  ssize_t n;
+  while ((n = read(fd, buf, sizeof(buf))) > 0)
+  {
+    res.append(buf, static_cast<size_t>(n));
+  }
+  return res;
+}
+
+}  // namespace
+
+TEST(stats_stream, fifo)
+{
+  std::string path = make_fifo();
+  int32_t fd       = open(path.c_str(), O_RDONLY | O_NONBLOCK);
+  ASSERT_GE(fd, 0);
+
+  StatsStream stream(path);
+  stream.write("{\"runs\":1}");
+  stream.write("{\"runs\":2}");
+  ASSERT_EQ(read_available(fd), "{\"runs\":1}\n{\"runs\":2}\n");
+  ASSERT_EQ(stream.get_num_dropped(), 0u);
+  close(fd);
+  remove_fifo(path);
+}
+
+TEST(stats_stream, fifo_without_reader)
+{
+  std::string path = make_fifo();
+
+  /* Records are dropped until a reader opens the FIFO. */
+  StatsStream stream(path);
+  stream.write("{\"runs\":1}");
+  ASSERT_EQ(stream.get_num_dropped(), 1u);
+
+  int32_t fd = open(path.c_str(), O_RDONLY | O_NONBLOCK);
+  ASSERT_GE(fd, 0);
+  stream.write("{\"runs\":2}");
+  ASSERT_EQ(read_available(fd), "{\"runs\":2}\n");
+  ASSERT_EQ(stream.get_num_dropped(), 1u);
+  close(fd);
+  remove_fifo(path);
+}
+
+TEST(stats_stream, fifo_reader_exits)
+{
+  std::string path = make_fifo();
+  int32_t fd       = open(path.c_str(), O_RDONLY | O_NONBLOCK);
+  ASSERT_GE(fd, 0);
+
+  StatsStream stream(path);
+  stream.write("{\"runs\":1}");
+  ASSERT_EQ(read_available(fd), "{\"runs\":1}\n");
+
+  /* The reader went away, writing must not raise SIGPIPE. */
+  close(fd);
+  stream.write("{\"runs\":2}");
+  stream.write("{\"runs\":3}");
+  ASSERT_EQ(stream.get_num_dropped(), 2u);
+
+  /* The FIFO is reopened once a new reader appears. */
+  fd = open(path.c_str(), O_RDONLY | O_NONBLOCK);
+  ASSERT_GE(fd, 0);
+  stream.write("{\"runs\":4}");
+  ASSERT_EQ(read_available(fd), "{\"runs\":4}\n");
+  ASSERT_EQ(stream.get_num_dropped(), 2u);
+  close(fd);
+  remove_fifo(path);
+}
@@ -0,0 +1,131 @@
+#include <signal.h>
+#include <unistd.h>
+
+#include "gtest/gtest.h"
+#include "supervisor.hpp"
+
+using namespace murxla;
+
+TEST(supervisor, exit)
+{
+  Supervisor supervisor;
+  pid_t pid = fork();
+  ASSERT_GE(pid, 0);
+  if (pid == 0) _exit(3);
+  supervisor.add(pid, 0);
+  auto event = supervisor.wait(-1);
+  ASSERT_TRUE(event);
+  ASSERT_EQ(event->d_kind, Supervisor::EventKind::EXIT);
+  ASSERT_EQ(event->d_pid, pid);
+  ASSERT_TRUE(WIFEXITED(event->d_status) && WEXITSTATUS(event->d_status) == 3);
+  ASSERT_TRUE(supervisor.empty());
+}
+
+TEST(supervisor, timeout)
+{
+  Supervisor supervisor;
+  pid_t pid = fork();
+  ASSERT_GE(pid, 0);
+  if (pid == 0)
+  {
+    pause();
+    _exit(0);
+  }
+  supervisor.add(pid, 0.05);
+  auto event = supervisor.wait(-1);
+  ASSERT_TRUE(event);
+  ASSERT_EQ(event->d_kind, Supervisor::EventKind::TIMEOUT);
+  ASSERT_EQ(event->d_pid, pid);
+  kill(pid, SIGKILL);
+  event = supervisor.wait(-1);
+  ASSERT_TRUE(event);
+  ASSERT_EQ(event->d_kind, Supervisor::EventKind::EXIT);
+  ASSERT_TRUE(WIFSIGNALED(event->d_status));
+}
+
+TEST(supervisor, reset_in_child)
+{
+  /* A forked child supervises its own child processes without interfering
+   * with the processes watched by the parent. */
+  Supervisor supervisor;
+  pid_t pid_sleep = fork();
+  ASSERT_GE(pid_sleep, 0);
+  if (pid_sleep == 0)
+  {
+    pause();
+    _exit(0);
+  }
+  supervisor.add(pid_sleep, 0.2);
+
+  pid_t pid = fork();
+  ASSERT_GE(pid, 0);
+  if (pid == 0)
+  {
+    supervisor.reset();
+    if (!supervisor.empty()) _exit(1);
+    pid_t pid_child = fork();
+    if (pid_child == 0) _exit(0);
+    supervisor.add(pid_child, 0.01);
+    auto event = supervisor.wait(-1);
+    _exit(event && event->d_pid == pid_child
+                  && event->d_kind == Supervisor::EventKind::EXIT
+                  && supervisor.empty()
+              ? 0
+              : 1);
+  }
+  supervisor.add(pid, 0);
+
+  auto event = supervisor.wait(-1, pid);
+  ASSERT_TRUE(event);
+  ASSERT_EQ(event->d_kind, Supervisor::EventKind::EXIT);
+  ASSERT_TRUE(WIFEXITED(event->d_status) && WEXITSTATUS(event->d_status) == 0);
+
+  /* The deadline of the process of the parent is still reported. */
+  event = supervisor.wait(-1);
+  ASSERT_TRUE(event);
+  ASSERT_EQ(event->d_kind, Supervisor::EventKind::TIMEOUT);
+  ASSERT_EQ(event->d_pid, pid_sleep);
+  kill(pid_sleep, SIGKILL);
+  event = supervisor.wait(-1);
+  ASSERT_TRUE(event);
+  ASSERT_EQ(event->d_kind, Supervisor::EventKind::EXIT);
+  ASSERT_EQ(event->d_pid, pid_sleep);
+}
+
+TEST(supervisor, interrupt)
+{
+  /* Waiting returns without an event when interrupted by a signal. */
+  signal(SIGUSR1, [](int32_t) {});
+  Supervisor supervisor;
+  pid_t pid_sleep = fork();
+  ASSERT_GE(pid_sleep, 0);
+  if (pid_sleep == 0)
+  {
+    pause();
+    _exit(0);
+  }
+  supervisor.add(pid_sleep, 0);
+
+  /* Signal repeatedly, the parent may not be blocked yet. */
+  pid_t parent = getpid();
+  pid_t pid    = fork();
+  ASSERT_GE(pid, 0);
+  if (pid == 0)
+  {
+    for (;;)
+    {
+      usleep(10000);
+      kill(parent, SIGUSR1);
+    }
+  }
+  ASSERT_FALSE(supervisor.wait(-1));
+  kill(pid, SIGKILL);
+  ASSERT_EQ(waitpid(pid, nullptr, 0), pid);
+
+  kill(pid_sleep, SIGKILL);
+  auto event = supervisor.wait(-1);
+  ASSERT_TRUE(event);
+  ASSERT_EQ(event->d_kind, Supervisor::EventKind::EXIT);
+  ASSERT_EQ(event->d_pid, pid_sleep);
+  signal(SIGUSR1, SIG_DFL);
+}